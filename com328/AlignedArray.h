@@ -0,0 +1,233 @@
+/**
+ * AlignedArray.h
+ *
+ * Generic Dynamic Array whose storage starts on a cache line boundary and
+ * is padded to a whole number of cache lines, so the SIMD kernels never
+ * split a load across lines. Adds sum, min, max and count_if reductions.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.1
+ */
+
+#ifndef ALIGNEDARRAY_H_
+#define ALIGNEDARRAY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include "Array.h"
+
+const int CACHE_LINE = 64;
+
+// Cache line aligned buffer. Held as a base class of AlignedArray so that
+// it exists before the Array base class is handed its address.
+template <class T>
+struct AlignedSlots {
+	T  *alignedSlots;
+	int alignedCount;
+
+	AlignedSlots() : alignedSlots(nullptr), alignedCount(0) {}
+	~AlignedSlots() { freeSlots(alignedSlots); }
+
+	// PostCondition: returns n rounded up to a whole number of cache lines
+	static int padded(int n) {
+		int perLine = (sizeof(T) < CACHE_LINE) ? CACHE_LINE / (int)sizeof(T) : 1;
+		return ((n + perLine - 1) / perLine) * perLine;
+	}
+
+	// PostCondition: returns uninitialised, cache line aligned storage for n elements.
+	//                The address returned by operator new is kept in the word before it
+	static T* allocateSlots(int n) {
+		if (n <= 0) {
+			return nullptr;
+		}
+		char *raw = static_cast<char*>(::operator new(sizeof(T) * n + CACHE_LINE + sizeof(void*)));
+		std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw + sizeof(void*));
+		char *aligned = reinterpret_cast<char*>((start + CACHE_LINE - 1) & ~std::uintptr_t(CACHE_LINE - 1));
+		reinterpret_cast<void**>(aligned)[-1] = raw;
+		return reinterpret_cast<T*>(aligned);
+	}
+
+	static void freeSlots(T *p) {
+		if (p != nullptr) {
+			::operator delete(reinterpret_cast<void**>(p)[-1]);
+		}
+	}
+
+	// PostCondition: storage for at least n elements allocated and returned
+	T* reserveSlots(int n) {
+		alignedCount = padded(n);
+		alignedSlots = allocateSlots(alignedCount);
+		return alignedSlots;
+	}
+
+	void swapSlots(AlignedSlots & other) noexcept {
+		std::swap(alignedSlots, other.alignedSlots);
+		std::swap(alignedCount, other.alignedCount);
+	}
+};
+
+template <class T, class Bounds = CheckedBounds>
+class AlignedArray : private AlignedSlots<T>, public Array<T, Bounds>
+{
+public:
+	explicit AlignedArray(int size=0);
+
+	AlignedArray(const AlignedArray & other);
+	AlignedArray(const Array<T, Bounds> & other);
+	AlignedArray(AlignedArray && other) noexcept;
+
+	AlignedArray& operator=(const AlignedArray & right);
+	AlignedArray& operator=(AlignedArray && right) noexcept;
+
+	void resize(int newSize);
+	void reserve(int newCapacity);
+	bool isAligned() const;
+
+	typename SumType<T>::type sum() const;
+	T min() const;
+	T max() const;
+	template <class Predicate>
+	int count_if(Predicate pred) const;
+
+private:
+	void grow(int newCapacity);
+};
+
+// ========================= IMPLEMENTATION AlignedArray.cpp ===================================
+
+// PreCondition: None
+// PostCondition: creates an array of specified size in cache line aligned storage
+template <class T, class Bounds>
+AlignedArray<T, Bounds>::AlignedArray(int size)
+	: AlignedSlots<T>(), Array<T, Bounds>(this->reserveSlots(size), this->padded(size), size) {}
+
+// PostCondition: aligned copy of other
+template <class T, class Bounds>
+AlignedArray<T, Bounds>::AlignedArray(const AlignedArray<T, Bounds> & other)
+	: AlignedSlots<T>(), Array<T, Bounds>(this->reserveSlots(other.length()), this->padded(other.length()), 0)
+{
+	Array<T, Bounds>::operator=(other);
+}
+
+// PostCondition: aligned copy of other
+template <class T, class Bounds>
+AlignedArray<T, Bounds>::AlignedArray(const Array<T, Bounds> & other)
+	: AlignedSlots<T>(), Array<T, Bounds>(this->reserveSlots(other.length()), this->padded(other.length()), 0)
+{
+	Array<T, Bounds>::operator=(other);
+}
+
+// PostCondition: aligned storage of other taken over, other is left empty without storage
+template <class T, class Bounds>
+AlignedArray<T, Bounds>::AlignedArray(AlignedArray<T, Bounds> && other) noexcept
+	: AlignedSlots<T>(), Array<T, Bounds>(nullptr, 0, 0)
+{
+	this->swapSlots(other);
+	this->swapStorage(other);
+}
+
+template <class T, class Bounds>
+AlignedArray<T, Bounds> & AlignedArray<T, Bounds>::operator=(const AlignedArray<T, Bounds> & right)
+{
+	if (this != &right) {
+		grow(right.length());
+		Array<T, Bounds>::operator=(right);
+	}
+	return *this;
+}
+
+template <class T, class Bounds>
+AlignedArray<T, Bounds> & AlignedArray<T, Bounds>::operator=(AlignedArray<T, Bounds> && right) noexcept
+{
+	// aligned storage of right taken over, right is left empty holding this storage
+	if (this != &right) {
+		this->release();
+		this->swapSlots(right);
+		this->swapStorage(right);
+	}
+	return *this;
+}
+
+// PreCondition: newSize is greater than 0
+// PostCondition: array is resized, storage remains cache line aligned
+template <class T, class Bounds>
+void AlignedArray<T, Bounds>::resize(int newSize)
+{
+	grow(newSize);
+	Array<T, Bounds>::resize(newSize);
+}
+
+// PreCondition: None
+// PostCondition: aligned storage is available for at least newCapacity elements
+template <class T, class Bounds>
+void AlignedArray<T, Bounds>::reserve(int newCapacity)
+{
+	grow(newCapacity);
+}
+
+// PostCondition: returns true if the elements start on a cache line boundary
+template <class T, class Bounds>
+bool AlignedArray<T, Bounds>::isAligned() const
+{
+	return reinterpret_cast<std::uintptr_t>(this->data()) % CACHE_LINE == 0;
+}
+
+// PostCondition: returns sum of the elements (ints are summed in 64 bits)
+template <class T, class Bounds>
+typename SumType<T>::type AlignedArray<T, Bounds>::sum() const
+{
+	return simdSum(this->data(), this->length());
+}
+
+// PreCondition: array is not empty
+// PostCondition: returns smallest element, throws out_of_range if array is empty
+template <class T, class Bounds>
+T AlignedArray<T, Bounds>::min() const
+{
+	if (this->length() == 0) {
+		throw std::out_of_range("AlignedArray: min of empty array");
+	}
+	return simdMin(this->data(), this->length());
+}
+
+// PreCondition: array is not empty
+// PostCondition: returns largest element, throws out_of_range if array is empty
+template <class T, class Bounds>
+T AlignedArray<T, Bounds>::max() const
+{
+	if (this->length() == 0) {
+		throw std::out_of_range("AlignedArray: max of empty array");
+	}
+	return simdMax(this->data(), this->length());
+}
+
+// PostCondition: returns number of elements for which pred is true. pred is
+//                called through a plain loop the compiler is free to vectorize
+template <class T, class Bounds>
+template <class Predicate>
+int AlignedArray<T, Bounds>::count_if(Predicate pred) const
+{
+	const T *p = this->data();
+	int c = 0;
+	for (int i = 0; i < this->length(); i++) {
+		c += pred(p[i]) ? 1 : 0;
+	}
+	return c;
+}
+
+// PostCondition: when newCapacity exceeds the aligned buffer, elements are moved
+//                to a larger aligned buffer and the old buffer is freed
+template <class T, class Bounds>
+void AlignedArray<T, Bounds>::grow(int newCapacity)
+{
+	if (newCapacity > this->alignedCount) {
+		int slots = this->padded(newCapacity);
+		T *bigger = this->allocateSlots(slots);
+		this->freeSlots(this->borrow(bigger, slots));
+		this->alignedSlots = bigger;
+		this->alignedCount = slots;
+	}
+}
+
+#endif
@@ -1,47 +1,123 @@
 /**
  * Array.h
  *
- * Generic Dynamic Array
+ * Generic Dynamic Array managing raw storage, with move aware
+ * growth, a memcpy fast path for trivially copyable types and
+ * a compile time bounds checking policy. Bulk operations use the
+ * vectorized kernels in SimdKernels.h and arrays persist as binary
+ * snapshots (Snapshot.h)
  *
  * @author  Aiden McCaughey
  * @email   a.mccaughey@ulster.ac.uk
- * @version 1.3.1
+ * @version 1.8
  */
 
 #ifndef ARRAY_H_
 #define ARRAY_H_
 
 #include <exception>
+#include <stdexcept>
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include "SimdKernels.h"
+#include "Snapshot.h"
 
-template <class T>
+// ======================== BOUNDS CHECKING POLICIES ======================================
+// Selects at compile time how an index is validated. valid() returns false only
+// when the caller should raise its own out_of_range error for the index.
+
+// Always check - the default, out of range indexes throw std::out_of_range
+struct CheckedBounds {
+	static bool valid(int index, int length) { return index >= 0 && index < length; }
+};
+
+// Check using assert in debug builds only, no cost when NDEBUG is defined
+struct AssertBounds {
+	static bool valid(int index, int length) { assert(index >= 0 && index < length); return true; }
+};
+
+// Never check - caller guarantees every index is in range
+struct UncheckedBounds {
+	static bool valid(int, int) { return true; }
+};
+
+// ======================== STORAGE TRAITS ================================================
+// Initial capacity of a container backed by Storage when none is given. Storages
+// with room of their own (SmallArray) specialise it so a default container fits it.
+template <class Storage>
+struct DefaultCapacity {
+	static const int value = 100;
+};
+
+template <class T, class Bounds = CheckedBounds>
 class Array
 {
 public:
 	explicit Array(int size=0);
 	~Array();
-	
-	Array(const Array<T> & ap);
+
+	Array(const Array & ap);
+	Array(Array && ap);		// not noexcept - see take()
 	Array(int size, const int *data);
-	
-	Array<T>& operator=(const Array<T> & right);
-	
+
+	Array& operator=(const Array & right);
+	Array& operator=(Array && right);
+
 	T& operator[](int index);
 	const T& operator[](int index) const;
+	T& unchecked_at(int index);
+	const T& unchecked_at(int index) const;
+	T* data();
+	const T* data() const;
 	int length() const;
-	
+	int capacity() const;
+
 	void resize(int newSize);
+	void reserve(int newCapacity);
+	void shrink_to_fit();
 	void initialise(T def=T());
 	void print(std::ostream & os=std::cout) const;
 	std::string toString() const;
 
+	void writeTo(SnapshotWriter & w) const;
+	void readFrom(SnapshotReader & r);
+
+protected:
+	// storage supplied by a derived class (e.g. an inline buffer) which is used
+	// whenever it is large enough but is never deallocated by the Array
+	Array(T *storage, int slots, int size);
+
+	bool isBorrowed() const;
+	void release();
+	T* borrow(T *storage, int slots);
+	void adopt(int size);
+	void swapStorage(Array & other) noexcept;
+
 private:
-	T *elements;
-	int capacity;
+	T *elements;	// raw storage, only the first count slots hold constructed elements
+	int count;		// number of constructed elements (the Array length)
+	int allocated;	// number of slots allocated in elements
+	T *borrowed;	// storage owned by a derived class, or nullptr
+	int borrowedSlots;
+
+	inline void deepCopy(const Array & original);
+	void take(Array & other);
+	void reallocate(int newCapacity);
+	static void outOfRange(int index);
 
-	inline void deepCopy(const Array<T> & original);
+	// raw storage helpers - trivially copyable types are copied and moved with memcpy
+	static T*   allocate(int n);
+	void        deallocate(T *p);
+	static void destroy(T *first, T *last);
+	static void copyConstruct(T *dest, const T *src, int n, std::true_type);
+	static void copyConstruct(T *dest, const T *src, int n, std::false_type);
+	static void moveConstruct(T *dest, T *src, int n, std::true_type);
+	static void moveConstruct(T *dest, T *src, int n, std::false_type);
 };
 
 
@@ -49,144 +125,247 @@ private:
 
 // PreCondition: size > 0
 // PostCondition: creates a dynamic array of specified size
-template <class T>
-Array<T>::Array(int size) 
+template <class T, class Bounds>
+Array<T, Bounds>::Array(int size) : borrowed(nullptr), borrowedSlots(0)
 {
 	if (size < 0) {
 		size = 0;
 	}
-	capacity = size;
-	elements = new T[capacity];
+	elements = allocate(size);
+	allocated = size;
+	for (count = 0; count < size; count++) {
+		new (elements + count) T;	// default initialise, as new T[size] would
+	}
 }
 
 // PreCondition: None
-// PostCondition: returns dynamically allocated memory used for elements to the heap and elements is set to null
-template <class T>
-Array<T>::~Array()
+// PostCondition: destroys elements and returns storage to the heap, elements is set to null
+template <class T, class Bounds>
+Array<T, Bounds>::~Array()
 {
-	delete [] elements;
-	elements = nullptr;
-	capacity = 0;
+	release();
 }
 
 // PreCondition: ap is a valid Array
-// PostCondition: Initalises new Array with deep copy of Array referenced by parameter ap 
-template <class T>
-Array<T>::Array(const Array<T> & ap)
+// PostCondition: Initalises new Array with deep copy of Array referenced by parameter ap
+template <class T, class Bounds>
+Array<T, Bounds>::Array(const Array<T, Bounds> & ap)
+	: elements(nullptr), count(0), allocated(0), borrowed(nullptr), borrowedSlots(0)
 {
 	deepCopy(ap);
 }
 
+// PreCondition: ap is a valid Array
+// PostCondition: takes ownership of the storage of ap, which is left empty
+template <class T, class Bounds>
+Array<T, Bounds>::Array(Array<T, Bounds> && ap)
+	: elements(nullptr), count(0), allocated(0), borrowed(nullptr), borrowedSlots(0)
+{
+	take(ap);
+}
+
+// PreCondition: storage is uninitialised and has room for slots elements
+// PostCondition: Array of specified size created using storage while it fits
+template <class T, class Bounds>
+Array<T, Bounds>::Array(T *storage, int slots, int size)
+	: elements(storage), count(0), allocated(slots), borrowed(storage), borrowedSlots(slots)
+{
+	resize(size);
+}
+
 // PreCondition: a is a C array
 // PostCondition: Initalises new Array with values contained in array data
-template <class T>
-Array<T>::Array(int size, const int *data)
+template <class T, class Bounds>
+Array<T, Bounds>::Array(int size, const int *data) : borrowed(nullptr), borrowedSlots(0)
 {
 	// create an Array of specified size
 	if (size < 0) {
 		size = 0;
 	}
-	capacity = size;
-	elements = new T[capacity];
+	elements = allocate(size);
+	allocated = size;
 
 	// populate the Array with supplied data
-	for (int i = 0; i < size; i++)
+	for (count = 0; count < size; count++)
 	{
-		elements[i] = data[i];
+		new (elements + count) T(data[count]);
 	}
 }
 
 
 // PreCondition: None
-// PostCondition: array referenced by right is copied into this
-template <class T>
-Array<T> & Array<T>::operator=(const Array<T> & right)
+// PostCondition: array referenced by right is copied into this, existing
+//                storage is reused when it is large enough
+template <class T, class Bounds>
+Array<T, Bounds> & Array<T, Bounds>::operator=(const Array<T, Bounds> & right)
 {
 	if (this != &right) {
-		delete [] elements;
-		deepCopy(right);
+		if (right.count <= allocated) {
+			int common = (count < right.count) ? count : right.count;
+			for (int i = 0; i < common; i++) {
+				elements[i] = right.elements[i];
+			}
+			copyConstruct(elements + common, right.elements + common, right.count - common, std::is_trivially_copyable<T>());
+			destroy(elements + right.count, elements + count);
+			count = right.count;
+		} else {
+			release();
+			deepCopy(right);
+		}
+	}
+	return *this;
+}
+
+// PreCondition: None
+// PostCondition: storage of right is moved into this, right is left empty
+template <class T, class Bounds>
+Array<T, Bounds> & Array<T, Bounds>::operator=(Array<T, Bounds> && right)
+{
+	if (this != &right) {
+		destroy(elements, elements + count);
+		count = 0;
+		take(right);
 	}
 	return *this;
 }
 
 // PreCondition: None
 // PostCondition: each position in array is initialised with def value
-template <class T>
-void Array<T>::initialise(T def) {
-	for(int i=0; i<capacity; i++)
-		elements[i] = def;
+template <class T, class Bounds>
+void Array<T, Bounds>::initialise(T def) {
+	simdFill(elements, count, def);
 }
 
 
-// PreCondition: memory allocated to elements has been released
-// PostCondition: copy of original used to initialise this arrasy
-template <class T>
-void Array<T>::deepCopy(const Array<T> & original)
+// PreCondition: array is empty and elements refers to borrowed storage (if any)
+// PostCondition: copy of original used to initialise this array
+template <class T, class Bounds>
+void Array<T, Bounds>::deepCopy(const Array<T, Bounds> & original)
 {
-	capacity = original.capacity;
-
-	elements = new T[capacity];
-	for (int i=0; i<capacity; i++) {
-		elements[i] = original.elements[i];
+	if (original.count > allocated) {
+		elements = allocate(original.count);
+		allocated = original.count;
 	}
+	copyConstruct(elements, original.elements, original.count, std::is_trivially_copyable<T>());
+	count = original.count;
 }
 
 // PreCondition: index is valid
-// PostCondition: reference to element at index returned
-template <class T>
-T& Array<T>::operator[](int index)
+// PostCondition: reference to element at index returned, index is validated
+//                as specified by the Bounds policy
+template <class T, class Bounds>
+inline T& Array<T, Bounds>::operator[](int index)
 {
-	if (index < 0 || index >= capacity) {
-		throw std::out_of_range("Array: index out of range " + std::to_string(index));
+	if (!Bounds::valid(index, count)) {
+		outOfRange(index);
 	}
-	
+
 	return elements[index];
 }
 
 // PreCondition: index is valid
-// PostCondition: reference to element at index returned
-template <class T>
-const T& Array<T>::operator[](int index) const
+// PostCondition: reference to element at index returned, index is validated
+//                as specified by the Bounds policy
+template <class T, class Bounds>
+inline const T& Array<T, Bounds>::operator[](int index) const
 {
-	if (index < 0 || index >= capacity) {
-		throw std::out_of_range("Array: index out of range " + std::to_string(index));
+	if (!Bounds::valid(index, count)) {
+		outOfRange(index);
 	}
-	
+
+	return elements[index];
+}
+
+// PreCondition: 0 <= index < length() - not checked
+// PostCondition: reference to element at index returned
+template <class T, class Bounds>
+inline T& Array<T, Bounds>::unchecked_at(int index)
+{
 	return elements[index];
 }
 
+// PreCondition: 0 <= index < length() - not checked
+// PostCondition: reference to element at index returned
+template <class T, class Bounds>
+inline const T& Array<T, Bounds>::unchecked_at(int index) const
+{
+	return elements[index];
+}
+
+// PreCondition: None
+// PostCondition: returns pointer to the contiguous elements (invalidated by growth)
+template <class T, class Bounds>
+inline T* Array<T, Bounds>::data()
+{
+	return elements;
+}
+
+template <class T, class Bounds>
+inline const T* Array<T, Bounds>::data() const
+{
+	return elements;
+}
+
 // PreCondition: newSize is greater than 0
-// PostCondition: array is resized
-template <class T>
-void Array<T>::resize(int newSize) 
+// PostCondition: array is resized, existing elements are moved (not copied)
+//                when new storage is required and only new slots are constructed
+template <class T, class Bounds>
+void Array<T, Bounds>::resize(int newSize)
 {
 	if (newSize > 0) {
-		auto *newArray = new T[newSize];
-		int limit = (newSize > capacity) ? capacity : newSize;
-
-		// copy existing elements to new array
-		for(int i=0; i<limit; i++) {
-			newArray[i] = elements[i];
+		if (newSize > allocated) {
+			reallocate(newSize);
 		}
+		// construct new slots or destroy surplus elements
+		for (; count < newSize; count++) {
+			new (elements + count) T;
+		}
+		destroy(elements + newSize, elements + count);
+		count = newSize;
+	}
+}
 
-		delete [] elements;
-		elements = newArray;
-		capacity = newSize;
-	}	
+// PreCondition: None
+// PostCondition: storage is available for at least newCapacity elements
+//                without changing the length of the array
+template <class T, class Bounds>
+void Array<T, Bounds>::reserve(int newCapacity)
+{
+	if (newCapacity > allocated) {
+		reallocate(newCapacity);
+	}
+}
+
+// PreCondition: None
+// PostCondition: unused storage beyond the length of the array is released
+template <class T, class Bounds>
+void Array<T, Bounds>::shrink_to_fit()
+{
+	if (allocated > count) {
+		reallocate(count);
+	}
 }
 
 // PreCondition: None
 // PostCondition: Returns length of Array
-template <class T>
-inline int Array<T>::length() const
+template <class T, class Bounds>
+inline int Array<T, Bounds>::length() const
 {
-	return capacity;
-} 
+	return count;
+}
+
+// PreCondition: None
+// PostCondition: Returns number of elements the Array can hold before reallocating
+template <class T, class Bounds>
+inline int Array<T, Bounds>::capacity() const
+{
+	return allocated;
+}
 
 // PreCondition: None
 // PostCondition: prints a copy of array to ostream
-template <class T>
-void Array<T>::print(std::ostream & os) const {
+template <class T, class Bounds>
+void Array<T, Bounds>::print(std::ostream & os) const {
 	os << "[ ";
 	for(int i=0; i<length(); i++) {
 		os << elements[i] << " ";
@@ -196,8 +375,8 @@ void Array<T>::print(std::ostream & os) const {
 
 // PreCondition: None
 // PostCondition: returns a string copy of array elements
-template <class T>
-std::string Array<T>::toString() const {
+template <class T, class Bounds>
+std::string Array<T, Bounds>::toString() const {
 	std::string s = "[ ";
 	for(int i=0; i<length(); i++) {
 		s += std::to_string(elements[i]) + " ";
@@ -206,10 +385,199 @@ std::string Array<T>::toString() const {
 	return s;
 }
 
+// PreCondition: None
+// PostCondition: length and elements written to snapshot
+template <class T, class Bounds>
+void Array<T, Bounds>::writeTo(SnapshotWriter & w) const
+{
+	w.writeTag("ARRY");
+	w.writeCount(count);
+	writeValues(w, elements, count);
+}
+
+// PreCondition: next container in snapshot is an Array
+// PostCondition: array replaced by the length and elements read from snapshot
+template <class T, class Bounds>
+void Array<T, Bounds>::readFrom(SnapshotReader & r)
+{
+	r.readTag("ARRY");
+	int n = r.readCount();
+	Array<T, Bounds> tmp(n);
+	readValues(r, tmp.elements, n);
+	*this = std::move(tmp);
+}
+
+// ------------------ Private storage management -------------------------
+
+// PreCondition: newCapacity >= count
+// PostCondition: elements moved in a single pass into storage of newCapacity slots,
+//                borrowed storage is preferred whenever newCapacity fits in it
+template <class T, class Bounds>
+void Array<T, Bounds>::reallocate(int newCapacity)
+{
+	bool fits = borrowed != nullptr && newCapacity <= borrowedSlots;
+	T *newElements = fits ? borrowed : allocate(newCapacity);
+	if (newElements != elements) {
+		moveConstruct(newElements, elements, count, std::is_trivially_copyable<T>());
+		deallocate(elements);
+		elements = newElements;
+	}
+	allocated = fits ? borrowedSlots : newCapacity;
+}
+
+// PreCondition: array is empty
+// PostCondition: contents of other moved into this and other left empty. Heap storage
+//                is taken over, elements in borrowed storage are moved one by one. That
+//                allocates if they do not fit, e.g. a SmallArray moved into an Array, so
+//                moving an Array can throw bad_alloc and is not declared noexcept
+template <class T, class Bounds>
+void Array<T, Bounds>::take(Array<T, Bounds> & other)
+{
+	if (other.elements != other.borrowed) {
+		deallocate(elements);
+		elements = other.elements;
+		allocated = other.allocated;
+		count = other.count;
+		other.elements = other.borrowed;
+		other.allocated = other.borrowedSlots;
+	} else {
+		if (other.count > allocated) {
+			reallocate(other.count);
+		}
+		moveConstruct(elements, other.elements, other.count, std::is_trivially_copyable<T>());
+		count = other.count;
+	}
+	other.count = 0;
+}
+
+// PostCondition: elements destroyed, storage returned to the heap and array is empty
+template <class T, class Bounds>
+void Array<T, Bounds>::release()
+{
+	destroy(elements, elements + count);
+	deallocate(elements);
+	elements = borrowed;
+	count = 0;
+	allocated = borrowedSlots;
+}
+
+// PreCondition: the owners of both arrays exchange their borrowed storage as well
+// PostCondition: elements and storage swapped with other in O(1), nothing is moved
+template <class T, class Bounds>
+void Array<T, Bounds>::swapStorage(Array<T, Bounds> & other) noexcept
+{
+	std::swap(elements, other.elements);
+	std::swap(count, other.count);
+	std::swap(allocated, other.allocated);
+	std::swap(borrowed, other.borrowed);
+	std::swap(borrowedSlots, other.borrowedSlots);
+}
+
+// PreCondition: storage is uninitialised and has room for slots >= length() elements
+// PostCondition: elements moved into storage, which is borrowed from now on. The
+//                previously borrowed storage is returned so its owner can free it
+template <class T, class Bounds>
+T* Array<T, Bounds>::borrow(T *storage, int slots)
+{
+	T *previous = borrowed;
+	moveConstruct(storage, elements, count, std::is_trivially_copyable<T>());
+	deallocate(elements);
+	elements = borrowed = storage;
+	allocated = borrowedSlots = slots;
+	return previous;
+}
+
+// PreCondition: array is empty and the first size slots of the borrowed storage
+//               already hold elements (e.g. records mapped from a file)
+// PostCondition: those elements become the contents of the array
+template <class T, class Bounds>
+void Array<T, Bounds>::adopt(int size)
+{
+	count = (size < borrowedSlots) ? size : borrowedSlots;
+}
+
+// PostCondition: returns true if elements are held in borrowed storage
+template <class T, class Bounds>
+bool Array<T, Bounds>::isBorrowed() const
+{
+	return borrowed != nullptr && elements == borrowed;
+}
+
+// PostCondition: throws out_of_range exception for index, kept out of line
+//                so indexing remains small enough to inline
+template <class T, class Bounds>
+void Array<T, Bounds>::outOfRange(int index)
+{
+	throw std::out_of_range("Array: index out of range " + std::to_string(index));
+}
+
+// PostCondition: returns uninitialised storage for n elements (nullptr when n is 0)
+template <class T, class Bounds>
+T* Array<T, Bounds>::allocate(int n)
+{
+	return (n > 0) ? static_cast<T*>(::operator new(sizeof(T) * n)) : nullptr;
+}
+
+template <class T, class Bounds>
+void Array<T, Bounds>::deallocate(T *p)
+{
+	if (p != borrowed) {
+		::operator delete(p);
+	}
+}
+
+// PostCondition: elements in range [first,last) are destroyed
+template <class T, class Bounds>
+void Array<T, Bounds>::destroy(T *first, T *last)
+{
+	if (!std::is_trivially_destructible<T>::value) {
+		for (; first < last; ++first) {
+			first->~T();
+		}
+	}
+}
+
+// PreCondition: dest refers to uninitialised storage for n elements
+// PostCondition: n elements of src copied into dest with one bulk copy
+template <class T, class Bounds>
+void Array<T, Bounds>::copyConstruct(T *dest, const T *src, int n, std::true_type)
+{
+	if (n > 0) {
+		std::memcpy(dest, src, sizeof(T) * n);
+	}
+}
+
+template <class T, class Bounds>
+void Array<T, Bounds>::copyConstruct(T *dest, const T *src, int n, std::false_type)
+{
+	for (int i = 0; i < n; i++) {
+		new (dest + i) T(src[i]);
+	}
+}
+
+// PreCondition: dest refers to uninitialised storage for n elements
+// PostCondition: n elements of src moved into dest and the sources destroyed
+template <class T, class Bounds>
+void Array<T, Bounds>::moveConstruct(T *dest, T *src, int n, std::true_type)
+{
+	if (n > 0) {
+		std::memcpy(dest, src, sizeof(T) * n);
+	}
+}
+
+template <class T, class Bounds>
+void Array<T, Bounds>::moveConstruct(T *dest, T *src, int n, std::false_type)
+{
+	for (int i = 0; i < n; i++) {
+		new (dest + i) T(std::move(src[i]));
+		src[i].~T();
+	}
+}
+
 // PreCondition: None
 // PostCondition: overload << operator to output array on ostream
-template <class T>
-std::ostream& operator <<(std::ostream& output, const Array<T>& p) {
+template <class T, class Bounds>
+std::ostream& operator <<(std::ostream& output, const Array<T, Bounds>& p) {
     p.print(output);
     return output;  // for multiple << operators.
 }
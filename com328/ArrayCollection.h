@@ -14,12 +14,12 @@
 
 #include "Array.h"
 
-template <class T>
+template <class T, class Bounds = CheckedBounds, class Storage = Array<T, Bounds> >
 class Collection
 {
 public:
-	explicit Collection(int size=100);
-	Collection(const Collection<T> & o);
+	explicit Collection(int size=DefaultCapacity<Storage>::value);
+	Collection(const Collection & o);
 
 	void add(const T & e);  
 	bool remove(const T & e);
@@ -29,13 +29,13 @@ public:
 	void clear();
 	bool isEmpty() const;
 
-	Collection<T>& operator=(const Collection<T>& right);
+	Collection& operator=(const Collection& right);
 	
-	bool operator==(const Collection<T> & other) const;
+	bool operator==(const Collection & other) const;
 	void print(std::ostream & out=std::cout ) const;
 
 protected:
-	Array<T> items;
+	Storage  items;
 	int      used;
 };
 
@@ -43,11 +43,11 @@ protected:
 /**
 * Construct the Collection
 */
-template <class T>
-Collection<T>::Collection(int size) : items(size), used{ 0 } { }
+template <class T, class Bounds, class Storage>
+Collection<T, Bounds, Storage>::Collection(int size) : items(size), used{ 0 } { }
 
-template <class T>
-Collection<T>::Collection(const Collection<T> & o) : items(o.items), used(o.used) { }
+template <class T, class Bounds, class Storage>
+Collection<T, Bounds, Storage>::Collection(const Collection<T, Bounds, Storage> & o) : items(o.items), used(o.used) { }
 
 
 /**
@@ -55,13 +55,13 @@ Collection<T>::Collection(const Collection<T> & o) : items(o.items), used(o.used
 * PreCondition:: none
 * PostCondition: element added to Collection
 */
-template <class T>
-void Collection<T>::add(const T & e)
+template <class T, class Bounds, class Storage>
+void Collection<T, Bounds, Storage>::add(const T & e)
 {        
 	if (used == items.length()) {
-		items.resize(used + (used/2));
+		items.resize(used + (used/2) + 1);
 	}
-	items[used] = e;    // add item to end of array
+	items.unchecked_at(used) = e;    // add item to end of array
 	used++;             // increment count     
 }
 
@@ -70,14 +70,14 @@ void Collection<T>::add(const T & e)
 * PreCondition: none
 * PostCondition: returns true if element removed, false otherwise
 */
-template <class T>
-bool Collection<T>::remove(const T & e)
+template <class T, class Bounds, class Storage>
+bool Collection<T, Bounds, Storage>::remove(const T & e)
 {
 	for(int i=0; i<used; i++) {
-		if (items[i] == e) {
+		if (items.unchecked_at(i) == e) {
 			// move all elements from i to end of array down one space
 			for(int p=i; p<used-1; p++) {
-				items[p] = items[p+1];
+				items.unchecked_at(p) = items.unchecked_at(p+1);
 			}
 			used--;
 			return true;
@@ -91,11 +91,11 @@ bool Collection<T>::remove(const T & e)
 * PreCondition: none
 * PostCondition: returns true if element found, false otherwise
 */
-template <class T>
-bool Collection<T>::find(const T & e) const
+template <class T, class Bounds, class Storage>
+bool Collection<T, Bounds, Storage>::find(const T & e) const
 {
 	for(int i=0; i<used; i++) {
-		if (items[i] == e) {
+		if (items.unchecked_at(i) == e) {
 			return true;
 		}
 	}
@@ -106,8 +106,8 @@ bool Collection<T>::find(const T & e) const
 * return number of elements in Collection.
 * PreCondition: none
 */
-template <class T>
-int Collection<T>::size() const
+template <class T, class Bounds, class Storage>
+int Collection<T, Bounds, Storage>::size() const
 {
 	return used;
 }
@@ -116,8 +116,8 @@ int Collection<T>::size() const
 * return number of elements in Collection.
 * PreCondition: none
 */
-template <class T>
-bool Collection<T>::isEmpty() const
+template <class T, class Bounds, class Storage>
+bool Collection<T, Bounds, Storage>::isEmpty() const
 {
 	return used == 0;
 }
@@ -126,12 +126,12 @@ bool Collection<T>::isEmpty() const
 * return number of occurrences of element in Collection.
 * PreCondition: none
 */
-template <class T>
-int Collection<T>::count(const T & e) const
+template <class T, class Bounds, class Storage>
+int Collection<T, Bounds, Storage>::count(const T & e) const
 {
 	int count = 0;
 	for(int i=0; i<used; i++) {
-		if (items[i] == e) { count++; }
+		if (items.unchecked_at(i) == e) { count++; }
 	}
 	return count;
 }
@@ -141,8 +141,8 @@ int Collection<T>::count(const T & e) const
 * PreCondition: None
 * PostCondition: count() == 0
 */
-template <class T>
-void Collection<T>::clear() {
+template <class T, class Bounds, class Storage>
+void Collection<T, Bounds, Storage>::clear() {
 	used = 0;
 }
 
@@ -150,26 +150,26 @@ void Collection<T>::clear() {
 /**
 * print elements in Collection to specified output stream.
 */
-template <class T>
-void Collection<T>::print(std::ostream & out ) const
+template <class T, class Bounds, class Storage>
+void Collection<T, Bounds, Storage>::print(std::ostream & out ) const
 {
 	out << "( ";
 	for (int i = 0; i < used; i++) {
-		out << items[i] << " ";
+		out << items.unchecked_at(i) << " ";
 	}
 	out << ")";
 }
 
 // PostCondition: returns true if other Collection contains exact same elements, otherwise false
-template <class T>
-bool Collection<T>::operator==(const Collection<T> & other) const 
+template <class T, class Bounds, class Storage>
+bool Collection<T, Bounds, Storage>::operator==(const Collection<T, Bounds, Storage> & other) const 
 {
 	bool same=true;
 	if (size() != other.size()) {
 		same = false;
 	}
 	for(int i=0; same && i<size(); i++) {
-		if (count(items[i]) != other.count(items[i])) {
+		if (count(items.unchecked_at(i)) != other.count(items.unchecked_at(i))) {
 			same = false;
 		}
 	} 
@@ -177,8 +177,8 @@ bool Collection<T>::operator==(const Collection<T> & other) const
 }
 
 // PostCondition: current Set overwritten by other
-template <class T>
-Collection<T> & Collection<T>::operator=(const Collection<T> & right) 
+template <class T, class Bounds, class Storage>
+Collection<T, Bounds, Storage> & Collection<T, Bounds, Storage>::operator=(const Collection<T, Bounds, Storage> & right) 
 {
 	if (this != &right) {
 		// underling Array class assignment operator will be called
@@ -190,8 +190,8 @@ Collection<T> & Collection<T>::operator=(const Collection<T> & right)
 
 // PreCondition: None
 // PostCondition: overload << operator to output Collection on ostream
-template <class T>
-std::ostream& operator <<(std::ostream& output, const Collection<T>& b) {
+template <class T, class Bounds, class Storage>
+std::ostream& operator <<(std::ostream& output, const Collection<T, Bounds, Storage>& b) {
 	b.print(output);
 	return output;  // for multiple << operators.
 }
@@ -6,274 +6,559 @@
 
  * @author  Aiden McCaughey
  * @email   a.mccaughey@ulster.ac.uk
- * @version 1.2
+ * @version 1.6
  */
 
 #ifndef ARRAYLIST_H
 #define ARRAYLIST_H
 
 #include "Array.h"
+#include "ArraySpan.h"
+#include <algorithm>
+#include <cstring>
 #include <exception>
+#include <functional>
 #include <iostream>
+#include <type_traits>
+#include <utility>
 
-template <class T>
+template <class Source> class ListView;
+template <class T> class SpanSource;
+
+// Bounds selects how positions are validated and Storage the backing array,
+// e.g. SmallArray<T, 16, Bounds> keeps lists of up to 16 elements off the heap
+template <class T, class Bounds = CheckedBounds, class Storage = Array<T, Bounds> >
 class ArrayList {
 public:
-	explicit ArrayList(int size=100);
-	ArrayList(const ArrayList<T> & other);
-	void operator=(const ArrayList<T> & other);
+	// iterators are plain pointers into the elements, valid until the list grows
+	typedef T        value_type;
+	typedef T*       iterator;
+	typedef const T* const_iterator;
+
+	explicit ArrayList(int size=DefaultCapacity<Storage>::value);
+	ArrayList(const ArrayList & other);
+	template <class U> ArrayList(const ArraySpan<U> & s);
+	template <class U> ArrayList(const ReverseSpan<U> & s);
+	void operator=(const ArrayList & other);
 	
-	bool operator==(const ArrayList<T> & other) const;
-	bool operator!=(const ArrayList<T> & other) const;
+	bool operator==(const ArrayList & other) const;
+	bool operator!=(const ArrayList & other) const;
 
 	void clear();
 	void add(const T & value);
 	void add(int pos, const T & value);
 	void remove(int pos);
+	template <class... Args>
+	void emplace(int pos, Args&&... args);
+	template <class U>
+	void addAll(int pos, const ArraySpan<U> & range);
+	void addAll(int pos, const ArrayList & other);
+	void removeRange(int first, int last);
+	template <class Pred>
+	int  removeIf(Pred pred);
+	void reserve(int capacity);
 	void set(int pos, const T & value);
 	T    get(int pos) const;
 	int  find(const T & value) const;
 
+	T&       operator[](int pos);
+	const T& operator[](int pos) const;
+	const T& at(int pos) const;
+	T*       data();
+	const T* data() const;
+
+	iterator       begin();
+	iterator       end();
+	const_iterator begin() const;
+	const_iterator end() const;
+
 	int  size() const;
 	bool isEmpty() const;
 	void print(std::ostream & os) const;
-   
-	// Immutable List processing functions
-	ArrayList<T> reverse() const;
-	ArrayList<T> take(int n) const;
-	ArrayList<T> drop(int n) const;
-	ArrayList<T> concat(const ArrayList<T> & other) const;
 
-	ArrayList<T> mid(int start, int count) const;
+	void writeTo(SnapshotWriter & w) const;
+	void readFrom(SnapshotReader & r);
+   
+	ArraySpan<T>       span();
+	ArraySpan<const T> span() const;
+
+	// Immutable List processing functions - take, drop, mid and reverse return views
+	// of this list without copying, convert a view to an ArrayList to keep a copy
+	ReverseSpan<T>       reverse();
+	ReverseSpan<const T> reverse() const;
+	ArraySpan<T>         take(int n);
+	ArraySpan<const T>   take(int n) const;
+	ArraySpan<T>         drop(int n);
+	ArraySpan<const T>   drop(int n) const;
+	ArraySpan<T>         mid(int start, int n);
+	ArraySpan<const T>   mid(int start, int n) const;
+	ArrayList concat(const ArrayList & other) const;
+
+	// Lazy pipeline, e.g. view().filter(p).map(f).take(k).collect() - see ListView.h
+	ListView< SpanSource<T> > view() const;
 	
 private:
-	Array<T> data;
+	Storage storage;
 	int count;
+
+	bool holds(const T *p, int n) const;
+	void openGap(int pos, int n);
+	void closeGap(int pos, int n);
+	static void shift(T *to, T *from, int n, std::true_type);
+	static void shift(T *to, T *from, int n, std::false_type);
 };
 
 // --------------- ArrayList Implementation -----------------------
 
 // Default Constructor
-template <class T>
-ArrayList<T>::ArrayList(int size) : data(size), count{ 0 } {}
+template <class T, class Bounds, class Storage>
+ArrayList<T, Bounds, Storage>::ArrayList(int size) : storage(size), count{ 0 } {}
 
 // PostCondition: construct ArrayList as a duplicate of c
-template <class T>
-ArrayList<T>::ArrayList(const ArrayList<T> & other): data(other.data), count(other.count) {}
+template <class T, class Bounds, class Storage>
+ArrayList<T, Bounds, Storage>::ArrayList(const ArrayList<T, Bounds, Storage> & other): storage(other.storage), count(other.count) {}
+
+// PostCondition: construct ArrayList holding a copy of the elements in view s
+template <class T, class Bounds, class Storage>
+template <class U>
+ArrayList<T, Bounds, Storage>::ArrayList(const ArraySpan<U> & s) : storage(s.length()), count(s.length())
+{
+	for (int i = 0; i < count; i++) {
+		storage.unchecked_at(i) = s.unchecked_at(i);
+	}
+}
+
+template <class T, class Bounds, class Storage>
+template <class U>
+ArrayList<T, Bounds, Storage>::ArrayList(const ReverseSpan<U> & s) : storage(s.length()), count(s.length())
+{
+	for (int i = 0; i < count; i++) {
+		storage.unchecked_at(i) = s.unchecked_at(i);
+	}
+}
 
 // PostCondition: assign c to ArrayList
-template<class T>
-void ArrayList<T>::operator=(const ArrayList<T> & other) 
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::operator=(const ArrayList<T, Bounds, Storage> & other) 
 {
-	data = other.data;
+	storage = other.storage;
 	count = other.count;
 }
 
 
 // PostCondition: returns true if ArrayLists are identical, false otherwise
-template <class T>
-bool ArrayList<T>::operator==(const ArrayList<T> & other) const 
+template <class T, class Bounds, class Storage>
+bool ArrayList<T, Bounds, Storage>::operator==(const ArrayList<T, Bounds, Storage> & other) const 
 {
-	bool same=true;
-	if (size() != other.size()) {
-		same = false;
-	}
-	for(int i=0; same && i<size(); i++) {
-		if (get(i) != other.get(i)) {
-			same = false;
-		}
-	} 
-    return same;
+	return size() == other.size() && std::equal(begin(), end(), other.begin());
 }
 
 // PostCondition: returns true if ArrayLists are not equal, false otherwise
-template <class T>
-bool ArrayList<T>::operator!=(const ArrayList<T> & other) const
+template <class T, class Bounds, class Storage>
+bool ArrayList<T, Bounds, Storage>::operator!=(const ArrayList<T, Bounds, Storage> & other) const
 {
 	return !operator== (other);
 }
 
 // PostCondition: return length of ArrayList
-template<class T>
-int ArrayList<T>::size() const {
+template<class T, class Bounds, class Storage>
+int ArrayList<T, Bounds, Storage>::size() const {
 	return count;
 }
 
 // PreCondition: pos is a valid ArrayList position and ArrayList is not full
 // PostCondition: inserts element value at specified position in ArrayList
-template<class T>
-void ArrayList<T>::add(int pos, const T & value) {
-	if (pos < 0 || pos > count) {
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::add(int pos, const T & value) {
+	if (!Bounds::valid(pos, count + 1)) {
 		throw std::out_of_range("ArrayList: invalid postion: " + std::to_string(pos));
 	}
 	// either throw execption if no room left in list
-	//if (count >= data.length()) 
+	//if (count >= storage.length()) 
 	//	throw std::overflow_error("ArrayList: overflow");
   
-	// or increase size of ArrayList if required
-	if (count >= data.length()) {
-		data.resize(data.length() * 2);
-	}
-	// make room for new element
-	for (int i = count; i > pos; i--) {
-		data[i] = data[i - 1];
+	// or increase size of ArrayList if required. value is copied first when
+	// it is an element of this list, as the gap would move or free it
+	if (holds(&value, 1)) {
+		T copy(value);
+		openGap(pos, 1);
+		storage.unchecked_at(pos) = std::move(copy);
+	} else {
+		openGap(pos, 1);
+		storage.unchecked_at(pos) = value;
 	}
-
-	// insert element in position
-	data[pos] = value;
-
-	// increment number of items in ArrayList
-	count++;
 }
 
 // PreCondition: ArrayList is not full
 // PostCondition: value added to end of ArrayList
-template<class T>
-void ArrayList<T>::add(const T & value) {
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::add(const T & value) {
 	add(size(), value);
 }
 
 // PreCondition: pos is a valid ArrayList position
 // PostCondition: remove element at specified position in  ArrayList
-template<class T>
-void ArrayList<T>::remove(int pos) {
-	if (pos < 0 || pos >= count) {
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::remove(int pos) {
+	if (!Bounds::valid(pos, count)) {
 		throw std::out_of_range("ArrayList: invalid postion: " + std::to_string(pos));
 	}
 	// fill gap by moving elements down
-	for (int i = pos; i < count - 1; i++) {
-		data[i] = data[i + 1];
+	closeGap(pos, 1);
+}
+
+// PreCondition: pos is a valid ArrayList position or size()
+// PostCondition: element constructed from args inserted at specified position
+template<class T, class Bounds, class Storage>
+template<class... Args>
+void ArrayList<T, Bounds, Storage>::emplace(int pos, Args&&... args) {
+	if (!Bounds::valid(pos, count + 1)) {
+		throw std::out_of_range("ArrayList: invalid postion: " + std::to_string(pos));
+	}
+	T value(std::forward<Args>(args)...);	// before the gap, args may be elements of this list
+	openGap(pos, 1);
+	storage.unchecked_at(pos) = std::move(value);
+}
+
+// PreCondition: pos is a valid ArrayList position or size()
+// PostCondition: elements of range inserted in order at specified position,
+//                existing elements are shifted once for the whole range
+template<class T, class Bounds, class Storage>
+template<class U>
+void ArrayList<T, Bounds, Storage>::addAll(int pos, const ArraySpan<U> & range) {
+	if (!Bounds::valid(pos, count + 1)) {
+		throw std::out_of_range("ArrayList: invalid postion: " + std::to_string(pos));
+	}
+	if (holds(range.data(), range.length())) {
+		// range is part of this list so would move with the gap - insert a copy
+		ArrayList<T, Bounds, Storage> copy(range);
+		addAll(pos, copy.span());
+		return;
+	}
+	int n = range.length();
+	openGap(pos, n);
+	for (int i = 0; i < n; i++) {
+		storage.unchecked_at(pos + i) = range.unchecked_at(i);
+	}
+}
+
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::addAll(int pos, const ArrayList<T, Bounds, Storage> & other) {
+	addAll(pos, other.span());
+}
+
+// PreCondition: 0 <= first <= last <= size()
+// PostCondition: elements at positions first..last-1 removed with a single shift
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::removeRange(int first, int last) {
+	if (first < 0 || first > last || last > count) {
+		throw std::out_of_range("ArrayList: invalid range: " + std::to_string(first) + ".." + std::to_string(last));
+	}
+	closeGap(first, last - first);
+}
+
+// PostCondition: every element for which pred is true removed in a single pass,
+//                order of remaining elements kept, returns number removed
+template<class T, class Bounds, class Storage>
+template<class Pred>
+int ArrayList<T, Bounds, Storage>::removeIf(Pred pred) {
+	int kept = 0;
+	for (int i = 0; i < count; i++) {
+		if (!pred(static_cast<const T &>(storage.unchecked_at(i)))) {
+			if (kept != i) {
+				storage.unchecked_at(kept) = std::move(storage.unchecked_at(i));
+			}
+			kept++;
+		}
+	}
+	int removed = count - kept;
+	count = kept;
+	return removed;
+}
+
+// PostCondition: list can hold at least capacity elements without growing
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::reserve(int capacity) {
+	if (capacity > storage.length()) {
+		storage.resize(capacity);
 	}
-	count--; // decrease length
 }
 
 // PreCondition: pos is a valid ArrayList position
 // PostCondition: retrieves element at specified position in ArrayList
-template<class T>
-T ArrayList<T>::get(int pos) const  {
-	if (pos < 0 || pos >= count) {
+template<class T, class Bounds, class Storage>
+T ArrayList<T, Bounds, Storage>::get(int pos) const  {
+	if (!Bounds::valid(pos, count)) {
 		throw std::out_of_range("ArrayList: invalid postion: " + std::to_string(pos));
 	}
-	return data[pos]; 
+	return storage.unchecked_at(pos); 
 }
 
 // PreCondition: pos is a valid ArrayList position
 // PostCondition: updates element at specified position in ArrayList
-template<class T>
-void ArrayList<T>::set(int pos, const T & value) {
-	if (pos < 0 || pos >= count) {
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::set(int pos, const T & value) {
+	if (!Bounds::valid(pos, count)) {
 		throw std::out_of_range("ArrayList: invalid postion: " + std::to_string(pos));
 	}
-	data[pos] = value;
+	storage.unchecked_at(pos) = value;
 }
 
 
 // PostCondition: returns postion of e in ArrayList or -1 if not found
-template<class T>
-int ArrayList<T>::find(const T & value) const {
-	for(int i=0; i<size(); i++) {
-		if (get(i) == value) {
-			return i;
-		}
+template<class T, class Bounds, class Storage>
+int ArrayList<T, Bounds, Storage>::find(const T & value) const {
+	const_iterator pos = std::find(begin(), end(), value);
+	return (pos != end()) ? (int)(pos - begin()) : -1;
+}
+
+// PreCondition: pos is a valid ArrayList position
+// PostCondition: reference to element at specified position in ArrayList
+template<class T, class Bounds, class Storage>
+inline T& ArrayList<T, Bounds, Storage>::operator[](int pos) {
+	if (!Bounds::valid(pos, count)) {
+		throw std::out_of_range("ArrayList: invalid postion: " + std::to_string(pos));
+	}
+	return storage.unchecked_at(pos);
+}
+
+template<class T, class Bounds, class Storage>
+inline const T& ArrayList<T, Bounds, Storage>::operator[](int pos) const {
+	if (!Bounds::valid(pos, count)) {
+		throw std::out_of_range("ArrayList: invalid postion: " + std::to_string(pos));
 	}
-	return -1;
+	return storage.unchecked_at(pos);
+}
+
+// PreCondition: pos is a valid ArrayList position
+// PostCondition: read only reference to element at pos, get without the copy
+template<class T, class Bounds, class Storage>
+inline const T& ArrayList<T, Bounds, Storage>::at(int pos) const {
+	return operator[](pos);
+}
+
+// PostCondition: pointer to the first of size() contiguous elements
+template<class T, class Bounds, class Storage>
+inline T* ArrayList<T, Bounds, Storage>::data() {
+	return storage.data();
+}
+
+template<class T, class Bounds, class Storage>
+inline const T* ArrayList<T, Bounds, Storage>::data() const {
+	return storage.data();
+}
+
+template<class T, class Bounds, class Storage>
+inline typename ArrayList<T, Bounds, Storage>::iterator ArrayList<T, Bounds, Storage>::begin() {
+	return storage.data();
+}
+
+template<class T, class Bounds, class Storage>
+inline typename ArrayList<T, Bounds, Storage>::iterator ArrayList<T, Bounds, Storage>::end() {
+	return storage.data() + count;
+}
+
+template<class T, class Bounds, class Storage>
+inline typename ArrayList<T, Bounds, Storage>::const_iterator ArrayList<T, Bounds, Storage>::begin() const {
+	return storage.data();
+}
+
+template<class T, class Bounds, class Storage>
+inline typename ArrayList<T, Bounds, Storage>::const_iterator ArrayList<T, Bounds, Storage>::end() const {
+	return storage.data() + count;
 }
 
 
 // PostCondition: prints contents of ArrayList to standard output
-template<class T>
-void ArrayList<T>::print(std::ostream & os) const {
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::print(std::ostream & os) const {
 	os << "[ ";
-	for(int i = 0; i < size(); i++) {
-		os << get(i) << " ";
+	for (const T & value : *this) {
+		os << value << " ";
 	}
 	os << "]";
 }
 
+// PostCondition: size and elements written to snapshot
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::writeTo(SnapshotWriter & w) const {
+	w.writeTag("ALST");
+	w.writeCount(count);
+	writeValues(w, storage.data(), count);
+}
+
+// PreCondition: next container in snapshot is an ArrayList
+// PostCondition: ArrayList replaced by the elements read from snapshot
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::readFrom(SnapshotReader & r) {
+	r.readTag("ALST");
+	int n = r.readCount();
+	if (n > storage.length()) {
+		storage.resize(n);
+	}
+	readValues(r, storage.data(), n);
+	count = n;
+}
+
 // PostCondition: ArrayList is emptied len == 0;
-template<class T>
-void ArrayList<T>::clear() {
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::clear() {
 	count = 0;				// reset length to zero
 }
 
 //PostCondition: returns length of ArrayList
-template<class T>
-bool ArrayList<T>::isEmpty() const {
+template<class T, class Bounds, class Storage>
+bool ArrayList<T, Bounds, Storage>::isEmpty() const {
 	return (count == 0);
 }
 
-template<class T>
-ArrayList<T> ArrayList<T>::reverse() const
+// PostCondition: view of all elements in the list
+template<class T, class Bounds, class Storage>
+ArraySpan<T> ArrayList<T, Bounds, Storage>::span()
 {
-	ArrayList<T> r(size());
-	for (int i = size()-1; i >= 0; i--) {
-		r.add(get(i));
-	}
-	return r;
+	return ArraySpan<T>(storage.data(), count);
 }
 
-template<class T>
-ArrayList<T> ArrayList<T>::take(int n) const
+template<class T, class Bounds, class Storage>
+ArraySpan<const T> ArrayList<T, Bounds, Storage>::span() const
 {
-	if (n < 0 || n > size()) {
-		throw std::out_of_range("ArrayList: invalid number of elements to take: " + std::to_string(n));
-	}
-	ArrayList<T> t(n);
-	for (int i = 0; i < n; i++) {
-		t.add(get(i));
-	}
-	return t;
+	return ArraySpan<const T>(storage.data(), count);
 }
 
-template<class T>
-ArrayList<T> ArrayList<T>::drop(int n) const
+// PostCondition: view of the list back to front
+template<class T, class Bounds, class Storage>
+ReverseSpan<T> ArrayList<T, Bounds, Storage>::reverse()
 {
-	if (n < 0 || n > size()) {
-		throw std::out_of_range("ArrayList: invalid number of elements to drop: " + std::to_string(n));
-	}
-//	return mid(n, size()-n); // drop(2) [1,2,3]
-	ArrayList<T> d(size()-n);
-	for (int i = n; i < size(); i++) {
-		d.add(get(i));
-	}
-	return d;
+	return span().reverse();
 }
 
-template<class T>
-ArrayList<T> ArrayList<T>::concat(const ArrayList<T> & other) const
+template<class T, class Bounds, class Storage>
+ReverseSpan<const T> ArrayList<T, Bounds, Storage>::reverse() const
 {
-	ArrayList<T> n(size() + other.size());
-	for (int i = 0; i < size(); i++) {
-		n.add(get(i));
-	}
-	for (int i = 0; i < other.size(); i++) {
-		n.add(other.get(i));
-	}
+	return span().reverse();
+}
+
+// PreCondition: 0 <= n <= size()
+// PostCondition: view of the first n elements
+template<class T, class Bounds, class Storage>
+ArraySpan<T> ArrayList<T, Bounds, Storage>::take(int n)
+{
+	return span().take(n);
+}
+
+template<class T, class Bounds, class Storage>
+ArraySpan<const T> ArrayList<T, Bounds, Storage>::take(int n) const
+{
+	return span().take(n);
+}
+
+// PreCondition: 0 <= n <= size()
+// PostCondition: view of all but the first n elements
+template<class T, class Bounds, class Storage>
+ArraySpan<T> ArrayList<T, Bounds, Storage>::drop(int n)
+{
+	return span().drop(n);
+}
+
+template<class T, class Bounds, class Storage>
+ArraySpan<const T> ArrayList<T, Bounds, Storage>::drop(int n) const
+{
+	return span().drop(n);
+}
+
+template<class T, class Bounds, class Storage>
+ArrayList<T, Bounds, Storage> ArrayList<T, Bounds, Storage>::concat(const ArrayList<T, Bounds, Storage> & other) const
+{
+	ArrayList<T, Bounds, Storage> n(size() + other.size());
+	n.addAll(0, span());
+	n.addAll(n.size(), other.span());
 	return n;
 }
 
-// PreCondition: start >= 0 && start < size() && count <= (size() - start)
-template<class T>
-ArrayList<T> ArrayList<T>::mid(int start, int count) const
+// PreCondition: start >= 0 && start < size() && n <= (size() - start)
+// PostCondition: view of n elements beginning at start
+template<class T, class Bounds, class Storage>
+ArraySpan<T> ArrayList<T, Bounds, Storage>::mid(int start, int n)
+{
+	return span().mid(start, n);
+}
+
+template<class T, class Bounds, class Storage>
+ArraySpan<const T> ArrayList<T, Bounds, Storage>::mid(int start, int n) const
+{
+	return span().mid(start, n);
+}
+
+// PostCondition: lazy view of the elements of the list
+template<class T, class Bounds, class Storage>
+ListView< SpanSource<T> > ArrayList<T, Bounds, Storage>::view() const
 {
-	if (start < 0 || start >= size() || count > size() - start) {
-		throw std::out_of_range("ArrayList: mid(" + std::to_string(start) + "," + std::to_string(count) + ") invalid");
+	return ListView< SpanSource<T> >(SpanSource<T>(span()));
+}
+
+// ------------------ Private element shifting -------------------------
+
+// PostCondition: true if any of the n elements from p lies in the storage of this list
+template<class T, class Bounds, class Storage>
+bool ArrayList<T, Bounds, Storage>::holds(const T *p, int n) const {
+	const T *base = storage.data();
+	std::less<const T*> before;
+	return n > 0 && before(p, base + storage.length()) && before(base, p + n);
+}
+
+// PreCondition: 0 <= pos <= size(), n >= 0
+// PostCondition: elements from pos moved up n places, growing the list if required,
+//                and size() increased by n. Positions pos..pos+n-1 are to be assigned
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::openGap(int pos, int n) {
+	if (count + n > storage.length()) {
+		int capacity = storage.length() > 0 ? storage.length() * 2 : 1;
+		storage.resize(capacity > count + n ? capacity : count + n);
+	}
+	if (n > 0 && pos < count) {
+		T *elements = storage.data();
+		shift(elements + pos + n, elements + pos, count - pos, std::is_trivially_copyable<T>());
+	}
+	count += n;
+}
+
+// PreCondition: 0 <= pos && pos + n <= size()
+// PostCondition: elements from pos+n moved down n places and size() reduced by n
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::closeGap(int pos, int n) {
+	if (n > 0 && pos + n < count) {
+		T *elements = storage.data();
+		shift(elements + pos, elements + pos + n, count - pos - n, std::is_trivially_copyable<T>());
 	}
-	//ArrayList<T> m(count - start);
-	//for (int i = start; i < start + count; i++) {
-	//	m.add(get(i));
-	//}
-	//return m;
-	return drop(start).take(count);
+	count -= n;
 }
 
+// PostCondition: n elements moved from from to to with a single memmove
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::shift(T *to, T *from, int n, std::true_type) {
+	std::memmove(static_cast<void*>(to), from, sizeof(T) * n);
+}
+
+// PostCondition: n elements move assigned from from to to, in the order that
+//                does not overwrite elements before they are moved
+template<class T, class Bounds, class Storage>
+void ArrayList<T, Bounds, Storage>::shift(T *to, T *from, int n, std::false_type) {
+	if (to < from) {
+		std::move(from, from + n, to);
+	} else {
+		std::move_backward(from, from + n, to + n);
+	}
+}
 
 // PreCondition: None
 // PostCondition: overload << operator to output ArrayList on ostream
-template <class T>
-std::ostream& operator <<(std::ostream& output, const ArrayList<T>& l) {
+template <class T, class Bounds, class Storage>
+std::ostream& operator <<(std::ostream& output, const ArrayList<T, Bounds, Storage>& l) {
 	l.print(output);
 	return output;  // for multiple << operators.
 }
 
+// ListView is written in terms of ArrayList so is included once ArrayList is complete
+#include "ListView.h"
+
 #endif /* ArrayList_H*/
\ No newline at end of file
@@ -2,102 +2,190 @@
  * ArrayQueue.h
  * 
  * Generic Queue based on circular Array implementation
- * with exception handling for underflow and overflow
+ * with exception handling for underflow and overflow.
+ * The ring buffer capacity is a power of two, so indexes
+ * wrap with a mask, and it can grow on demand (see the
+ * capacity policies below)
  *
  * @author  Aiden McCaughey
  * @email   a.mccaughey@ulster.ac.uk
- * @version 1.1
+ * @version 1.2
  *
  */
 
 #ifndef _ARRAYQUEUE_H
 #define _ARRAYQUEUE_H
 
+#include <algorithm>
 #include <exception>
+#include <utility>
 #include "Array.h"
 
-template <class T>
+// ======================== CAPACITY POLICIES =============================================
+// Selects at compile time what enqueue does when the queue is full
+
+// Fixed - the default, a queue of n holds at most n elements, more throw std::overflow_error
+struct FixedCapacity {
+	static const bool grows = false;
+};
+
+// Growable - the ring buffer doubles when full, n is only the initial capacity
+struct GrowableCapacity {
+	static const bool grows = true;
+};
+
+template <class T, class Bounds = CheckedBounds, class Capacity = FixedCapacity>
 class Queue {
 public:
     explicit Queue(int n=100);
 
-	T peek() const;
+	const T & peek() const;
     void dequeue();
     void enqueue(const T & x);
+    int  enqueueN(const T * items, int n);
+    int  dequeueN(T * items, int n);
     void clear();
 
 	bool isEmpty() const;
     int size() const;
+    int capacity() const;
 
 private:
-    Array<T> data;
+    static int ringSize(int n);
+    void grow(int needed);
+
+    Array<T, Bounds> data;	// length is a power of two
+    int mask;				// data.length() - 1
+    int limit;				// most elements held, n unless Capacity grows
     int count;
-    int front;
-    int back;
+    int front;				// index of the least recently inserted element
 };
 
 // ========================= IMPLEMENTATION Stack.cpp ===================================
 
-// PostCondition: empty queue initialised
-template <class T>
-Queue<T>::Queue(int n) : data(n), count{ 0 }, front{ 0 }, back{ data.length() - 1 } {}
+// PostCondition: empty queue initialised, with a ring buffer of the power of two >= n
+template <class T, class Bounds, class Capacity>
+Queue<T, Bounds, Capacity>::Queue(int n) : data(ringSize(n)), mask{ ringSize(n) - 1 }, limit{ n }, count{ 0 }, front{ 0 } {}
 
 // PostCondition: Return true if empty, false, otherwise.
-template <class T>
-bool Queue<T>::isEmpty() const {
+template <class T, class Bounds, class Capacity>
+bool Queue<T, Bounds, Capacity>::isEmpty() const {
     return (count == 0);
 }
 
 // PostCondition: return number of elements in the queue
-template <class T>
-int Queue<T>::size() const {
+template <class T, class Bounds, class Capacity>
+int Queue<T, Bounds, Capacity>::size() const {
     return count;
 }
 
+// PostCondition: return number of elements the queue holds before it is full, or grows
+template <class T, class Bounds, class Capacity>
+int Queue<T, Bounds, Capacity>::capacity() const {
+    return Capacity::grows ? data.length() : limit;
+}
+
 // PostCondition: make the queue logically empty.
-template <class T>
-void Queue<T>::clear() {
+template <class T, class Bounds, class Capacity>
+void Queue<T, Bounds, Capacity>::clear() {
     count = 0;
     front = 0;
-    back = data.length() - 1;
 }
 
 // PreCondition: the queue is not empty
 // PostCondition: return the least recently inserted item in the queue.
-template <class T>
-T Queue<T>::peek() const {
+template <class T, class Bounds, class Capacity>
+const T & Queue<T, Bounds, Capacity>::peek() const {
 	// check for underflow
 	if (size() < 1) {
 		throw std::underflow_error("queue underflow");
 	}
-	return data[ front ];
+	return data.unchecked_at( front );
 }
 
 
 // PreCondition: the queue is not empty
 // PostCondition: remove the least recently inserted item in the queue.
-template <class T>
-void Queue<T>::dequeue() {
+template <class T, class Bounds, class Capacity>
+void Queue<T, Bounds, Capacity>::dequeue() {
 	// check for underflow
 	if (size() < 1) {
 		throw std::underflow_error("queue underflow");
 	}
-	front = (front + 1) % data.length();
+	front = (front + 1) & mask;
 	count--;
 }
 
-// PreCondition: the queue is not full
+// PreCondition: the queue is not full, unless Capacity grows
 // PostCondition: element is added to end of the queue
-template <class T>
-void Queue<T>::enqueue(const T & x) {
+template <class T, class Bounds, class Capacity>
+void Queue<T, Bounds, Capacity>::enqueue(const T & x) {
+	if (count == data.length() && Capacity::grows) {
+		grow(count + 1);
+	}
 	// check for overflow
-	if (size() >= data.length()) {
+	if (size() >= capacity()) {
 		throw std::overflow_error("queue overflow");
 	}
-    back = (back + 1) % data.length();
-    data[ back ] = x;
+    data.unchecked_at( (front + count) & mask ) = x;
     count++;
 }
 
-#endif /* _ARRAYQUEUE_H */
+// PostCondition: items[0..n-1] added to end of the queue in order, in at most two
+//                contiguous copies. Returns the number added, all n unless a fixed
+//                capacity queue fills first
+template <class T, class Bounds, class Capacity>
+int Queue<T, Bounds, Capacity>::enqueueN(const T * items, int n) {
+	if (Capacity::grows && count + n > data.length()) {
+		grow(count + n);
+	}
+	n = std::max(0, std::min(n, capacity() - count));
+	int back = (front + count) & mask;
+	int first = std::min(n, data.length() - back);	// up to the end of the buffer
+	std::copy(items, items + first, data.data() + back);
+	std::copy(items + first, items + n, data.data());
+	count += n;
+	return n;
+}
+
+// PostCondition: up to n least recently inserted items moved to items[0..] in order, in
+//                at most two contiguous copies, and removed. Returns the number removed
+template <class T, class Bounds, class Capacity>
+int Queue<T, Bounds, Capacity>::dequeueN(T * items, int n) {
+	n = std::max(0, std::min(n, count));
+	int first = std::min(n, data.length() - front);	// up to the end of the buffer
+	std::move(data.data() + front, data.data() + front + first, items);
+	std::move(data.data(), data.data() + n - first, items + first);
+	front = (front + n) & mask;
+	count -= n;
+	return n;
+}
+
+// PostCondition: returns smallest power of two >= n
+template <class T, class Bounds, class Capacity>
+int Queue<T, Bounds, Capacity>::ringSize(int n) {
+	int slots = 1;
+	while (slots < n) {
+		slots *= 2;
+	}
+	return slots;
+}
 
+// PostCondition: ring buffer doubled until it holds needed elements, those queued are
+//                moved to its start in order, so a wrapped queue is unrolled
+template <class T, class Bounds, class Capacity>
+void Queue<T, Bounds, Capacity>::grow(int needed) {
+	int slots = data.length();
+	while (slots < needed) {
+		slots *= 2;
+	}
+	Array<T, Bounds> bigger(slots);
+	int first = std::min(count, data.length() - front);
+	std::move(data.data() + front, data.data() + front + first, bigger.data());
+	std::move(data.data(), data.data() + count - first, bigger.data() + first);
+	data = std::move(bigger);
+	mask = slots - 1;
+	front = 0;
+}
+
+#endif /* _ARRAYQUEUE_H */
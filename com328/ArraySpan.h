@@ -0,0 +1,289 @@
+/**
+ * ArraySpan.h
+ *
+ * Non-owning views over a contiguous run of elements. An ArraySpan views
+ * the elements in order and a ReverseSpan views them back to front. Taking,
+ * dropping, slicing or reversing a view creates another view without
+ * copying or allocating.
+ *
+ * A view refers to the elements of the Array (or ArrayList) it was created
+ * from, so it is only valid while that container is alive and not resized.
+ * Use ArraySpan<const T> for a read only view.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.0
+ */
+
+#ifndef ARRAYSPAN_H_
+#define ARRAYSPAN_H_
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "Array.h"
+
+template <class T> class ReverseSpan;
+
+template <class T>
+class ArraySpan {
+public:
+	typedef typename std::remove_const<T>::type value_type;
+
+	ArraySpan() : first(nullptr), count(0) {}
+	ArraySpan(T *first, int count) : first(first), count(count) {}
+	template <class U>
+	ArraySpan(const ArraySpan<U> & other) : first(other.data()), count(other.length()) {}
+	template <class Bounds>
+	ArraySpan(Array<value_type, Bounds> & a) : first(a.data()), count(a.length()) {}
+	template <class Bounds>
+	ArraySpan(const Array<value_type, Bounds> & a) : first(a.data()), count(a.length()) {}
+
+	T&   operator[](int index) const;
+	T&   unchecked_at(int index) const;
+	T    get(int pos) const;
+	int  length() const		{ return count; }
+	int  size() const		{ return count; }
+	bool isEmpty() const	{ return count == 0; }
+	T*   data() const		{ return first; }
+	T*   begin() const		{ return first; }
+	T*   end() const		{ return first + count; }
+	int  find(const value_type & value) const;
+	void print(std::ostream & os) const;
+
+	// Immutable view functions - views of the same elements, nothing is copied
+	ArraySpan      take(int n) const;
+	ArraySpan      drop(int n) const;
+	ArraySpan      mid(int start, int n) const;
+	ReverseSpan<T> reverse() const;
+
+private:
+	T  *first;
+	int count;
+};
+
+template <class T>
+class ReverseSpan {
+public:
+	typedef typename std::remove_const<T>::type value_type;
+
+	ReverseSpan() : first(nullptr), count(0) {}
+	ReverseSpan(T *first, int count) : first(first), count(count) {}
+	template <class U>
+	ReverseSpan(const ReverseSpan<U> & other) : first(other.reverse().data()), count(other.length()) {}
+
+	T&   operator[](int index) const;
+	T&   unchecked_at(int index) const;
+	T    get(int pos) const;
+	int  length() const		{ return count; }
+	int  size() const		{ return count; }
+	bool isEmpty() const	{ return count == 0; }
+	int  find(const value_type & value) const;
+	void print(std::ostream & os) const;
+
+	// Immutable view functions - views of the same elements, nothing is copied
+	ReverseSpan  take(int n) const;
+	ReverseSpan  drop(int n) const;
+	ReverseSpan  mid(int start, int n) const;
+	ArraySpan<T> reverse() const;
+
+private:
+	T  *first;	// first element of the underlying (forward) run
+	int count;
+};
+
+// ========================= IMPLEMENTATION ArraySpan.cpp ===================================
+
+// PreCondition: index is valid
+// PostCondition: reference to element at index returned, throws out_of_range otherwise
+template <class T>
+T& ArraySpan<T>::operator[](int index) const {
+	if (index < 0 || index >= count) {
+		throw std::out_of_range("ArraySpan: index out of range " + std::to_string(index));
+	}
+	return first[index];
+}
+
+// PreCondition: 0 <= index < length() - not checked
+template <class T>
+inline T& ArraySpan<T>::unchecked_at(int index) const {
+	return first[index];
+}
+
+// PreCondition: pos is a valid position
+// PostCondition: returns copy of element at pos, throws out_of_range otherwise
+template <class T>
+T ArraySpan<T>::get(int pos) const {
+	return operator[](pos);
+}
+
+// PostCondition: returns position of value in view, or -1 if not found
+template <class T>
+int ArraySpan<T>::find(const value_type & value) const {
+	for (int i = 0; i < count; i++) {
+		if (first[i] == value) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+template <class T>
+void ArraySpan<T>::print(std::ostream & os) const {
+	os << "[ ";
+	for (int i = 0; i < count; i++) {
+		os << first[i] << " ";
+	}
+	os << "]";
+}
+
+// PreCondition: 0 <= n <= length()
+// PostCondition: view of the first n elements
+template <class T>
+ArraySpan<T> ArraySpan<T>::take(int n) const {
+	if (n < 0 || n > count) {
+		throw std::out_of_range("ArraySpan: invalid number of elements to take: " + std::to_string(n));
+	}
+	return ArraySpan<T>(first, n);
+}
+
+// PreCondition: 0 <= n <= length()
+// PostCondition: view of all but the first n elements
+template <class T>
+ArraySpan<T> ArraySpan<T>::drop(int n) const {
+	if (n < 0 || n > count) {
+		throw std::out_of_range("ArraySpan: invalid number of elements to drop: " + std::to_string(n));
+	}
+	return ArraySpan<T>(first + n, count - n);
+}
+
+// PreCondition: start >= 0 && start < length() && n <= (length() - start)
+// PostCondition: view of n elements beginning at start
+template <class T>
+ArraySpan<T> ArraySpan<T>::mid(int start, int n) const {
+	if (start < 0 || start >= count || n < 0 || n > count - start) {
+		throw std::out_of_range("ArraySpan: mid(" + std::to_string(start) + "," + std::to_string(n) + ") invalid");
+	}
+	return ArraySpan<T>(first + start, n);
+}
+
+// PostCondition: view of the same elements back to front
+template <class T>
+ReverseSpan<T> ArraySpan<T>::reverse() const {
+	return ReverseSpan<T>(first, count);
+}
+
+// PreCondition: index is valid
+// PostCondition: reference to element index places from the end of the underlying run
+template <class T>
+T& ReverseSpan<T>::operator[](int index) const {
+	if (index < 0 || index >= count) {
+		throw std::out_of_range("ReverseSpan: index out of range " + std::to_string(index));
+	}
+	return first[count - 1 - index];
+}
+
+// PreCondition: 0 <= index < length() - not checked
+template <class T>
+inline T& ReverseSpan<T>::unchecked_at(int index) const {
+	return first[count - 1 - index];
+}
+
+template <class T>
+T ReverseSpan<T>::get(int pos) const {
+	return operator[](pos);
+}
+
+template <class T>
+int ReverseSpan<T>::find(const value_type & value) const {
+	for (int i = 0; i < count; i++) {
+		if (unchecked_at(i) == value) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+template <class T>
+void ReverseSpan<T>::print(std::ostream & os) const {
+	os << "[ ";
+	for (int i = 0; i < count; i++) {
+		os << unchecked_at(i) << " ";
+	}
+	os << "]";
+}
+
+// PreCondition: 0 <= n <= length()
+// PostCondition: view of the first n elements, i.e. the last n of the underlying run
+template <class T>
+ReverseSpan<T> ReverseSpan<T>::take(int n) const {
+	if (n < 0 || n > count) {
+		throw std::out_of_range("ReverseSpan: invalid number of elements to take: " + std::to_string(n));
+	}
+	return ReverseSpan<T>(first + count - n, n);
+}
+
+template <class T>
+ReverseSpan<T> ReverseSpan<T>::drop(int n) const {
+	if (n < 0 || n > count) {
+		throw std::out_of_range("ReverseSpan: invalid number of elements to drop: " + std::to_string(n));
+	}
+	return ReverseSpan<T>(first, count - n);
+}
+
+template <class T>
+ReverseSpan<T> ReverseSpan<T>::mid(int start, int n) const {
+	if (start < 0 || start >= count || n < 0 || n > count - start) {
+		throw std::out_of_range("ReverseSpan: mid(" + std::to_string(start) + "," + std::to_string(n) + ") invalid");
+	}
+	return ReverseSpan<T>(first + count - start - n, n);
+}
+
+template <class T>
+ArraySpan<T> ReverseSpan<T>::reverse() const {
+	return ArraySpan<T>(first, count);
+}
+
+// PostCondition: returns true if both views hold equal elements in the same order
+template <class T, class U>
+bool operator==(const ArraySpan<T> & a, const ArraySpan<U> & b) {
+	bool same = a.length() == b.length();
+	for (int i = 0; same && i < a.length(); i++) {
+		same = a.unchecked_at(i) == b.unchecked_at(i);
+	}
+	return same;
+}
+
+template <class T, class U>
+bool operator!=(const ArraySpan<T> & a, const ArraySpan<U> & b) {
+	return !(a == b);
+}
+
+template <class T, class U>
+bool operator==(const ReverseSpan<T> & a, const ReverseSpan<U> & b) {
+	bool same = a.length() == b.length();
+	for (int i = 0; same && i < a.length(); i++) {
+		same = a.unchecked_at(i) == b.unchecked_at(i);
+	}
+	return same;
+}
+
+template <class T, class U>
+bool operator!=(const ReverseSpan<T> & a, const ReverseSpan<U> & b) {
+	return !(a == b);
+}
+
+template <class T>
+std::ostream& operator <<(std::ostream& output, const ArraySpan<T>& s) {
+	s.print(output);
+	return output;
+}
+
+template <class T>
+std::ostream& operator <<(std::ostream& output, const ReverseSpan<T>& s) {
+	s.print(output);
+	return output;
+}
+
+#endif
@@ -14,11 +14,11 @@
 #include <exception>
 #include "Array.h"
 
-template <class T>
+template <class T, class Bounds = CheckedBounds, class Storage = Array<T, Bounds> >
 class Stack
 {
 public:
-	explicit Stack(int n=100);
+	explicit Stack(int n=DefaultCapacity<Storage>::value);
 	void pop();
 	T top() const;
 	void push(const T & element);
@@ -27,7 +27,7 @@ public:
 	int size() const;
 
 private:
-	Array<T> data;
+	Storage data;
 	int count;
 };
 
@@ -36,14 +36,14 @@ private:
 
 // PreCondition: None
 // PostCondition: creates a Stack
-template <class T>
-Stack<T>::Stack(int n) : data(n), count{ -1 } { }
+template <class T, class Bounds, class Storage>
+Stack<T, Bounds, Storage>::Stack(int n) : data(n), count{ -1 } { }
 
 
 // PreCondition: Stack is not empty
 // PostCondition: removes top element from Stack
-template <class T>
-void Stack<T>::pop()
+template <class T, class Bounds, class Storage>
+void Stack<T, Bounds, Storage>::pop()
 {
 	if (isEmpty()) {
 		throw std::underflow_error("stack underflow");
@@ -55,23 +55,23 @@ void Stack<T>::pop()
 
 // PreCondition: Stack is not empty
 // PostCondition: return a copy of top element from stack
-template <class T>
-T Stack<T>::top() const
+template <class T, class Bounds, class Storage>
+T Stack<T, Bounds, Storage>::top() const
 {
 	if (isEmpty()) {
 		throw std::underflow_error("stack underflow");
 	} 
 
-	return data[count];		
+	return data.unchecked_at(count);		
 }
 
 // PreCondition: Stack is not full
 // PostCondition: Add specified element to top of stack
-template <class T>
-void Stack<T>::push(const T & element) 
+template <class T, class Bounds, class Storage>
+void Stack<T, Bounds, Storage>::push(const T & element) 
 {
 	if (count < data.length() - 1) {
-		data[++count] = element;
+		data.unchecked_at(++count) = element;
 	}
 	else {
 		throw std::overflow_error("stack overflow");
@@ -80,24 +80,24 @@ void Stack<T>::push(const T & element)
 
 // PreCondition: None
 // PostCondition: return true if stack is empty and false otherwise
-template <class T>
-bool Stack<T>::isEmpty() const
+template <class T, class Bounds, class Storage>
+bool Stack<T, Bounds, Storage>::isEmpty() const
 {
 	return count == -1;
 }
 
 // PreCondition: None
 // PostCondition: empty the stack
-template <class T>
-void Stack<T>::clear()
+template <class T, class Bounds, class Storage>
+void Stack<T, Bounds, Storage>::clear()
 {
 	count = -1;
 }
 
 // PreCondition: None
 // PostCondition: return number of entries on stack
-template <class T>
-int Stack<T>::size() const
+template <class T, class Bounds, class Storage>
+int Stack<T, Bounds, Storage>::size() const
 {
 	return count + 1;
 }
@@ -1,12 +1,13 @@
 /**********************************************************************
 * Name        : BinaryTree.h
 * Author      : a.mccaughey@ulster.ac.uk
-* Version     : 1.0
+* Version     : 1.1
 * Description : Dynamic BinarySearch Tree class with public BinNode
 *********************************************************************/
 #ifndef BinaryTree_H_
 #define BinaryTree_H_
 #include "Array.h"
+#include "NodePool.h"
 #include <cstdlib>
 #include <fstream>
 
@@ -20,13 +21,14 @@ struct BinNode {
 	BinNode<T> *right;
 };
 
-template <class T>
+// Nodes selects how nodes are allocated, see NodePool.h
+template <class T, class Nodes = NodePool< BinNode<T> > >
 class BinaryTree {
 public:
 	BinaryTree();
 	~BinaryTree();
-	BinaryTree(const BinaryTree<T>& t);
-	const BinaryTree& operator=(const BinaryTree<T>& rhs);
+	BinaryTree(const BinaryTree& t);
+	const BinaryTree& operator=(const BinaryTree& rhs);
 
 	void insert(const T & e);
 	void clear();
@@ -42,12 +44,16 @@ public:
 	void loadFrom(const Array<T> & a);
 	void extractTo(Array<T> & a);
 
+	void writeTo(SnapshotWriter & w) const;
+	void readFrom(SnapshotReader & r);
+
 	int size() const;
 	int height() const;
 
 private:
 	BinNode<T>* root;
 	int tsize;
+	Nodes nodes;
 
 	BinNode<T>*	insert(const T & e, BinNode<T>* n);
 	BinNode<T>*	remove(const T & e, BinNode<T>* n);
@@ -57,46 +63,50 @@ private:
 	void        displayPostOrder(BinNode<T>* n, std::ostream & os) const;
 
 	BinNode<T>* findMin(BinNode<T>* n) const;
-	void        clear(BinNode<T>* n);
+	void        discard(BinNode<T>* n);
 	BinNode<T>* copy(BinNode<T>* n);
 	int         subTreeHeight(BinNode<T>* n) const;
 
-	void extractTo(Array<T> & a, int & pos, BinNode<T>* n);
+	void extractTo(Array<T> & a, int & pos, BinNode<T>* n) const;
+	BinNode<T>* buildBalanced(const Array<T> & a, int low, int high);
 };
 
 
 // ========================= IMPLEMENTATION BinaryTree.cpp ===================================
 
 // Constructor: initialises empty binary tree
-template <class T>
-BinaryTree<T>::BinaryTree() : root(nullptr), tsize(0) { }
+template <class T, class Nodes>
+BinaryTree<T, Nodes>::BinaryTree() : root(nullptr), tsize(0) { }
 
 // Copy Constructor: initialises BinaryTree from Tree passed as const parameter
-template <class T>
-BinaryTree<T>::BinaryTree(const BinaryTree<T> & t) {
+template <class T, class Nodes>
+BinaryTree<T, Nodes>::BinaryTree(const BinaryTree<T, Nodes> & t) {
 	root = copy(t.root);
 	tsize = t.tsize;
 }
 
 // Destructor: deletes binary tree
-template <class T>
-BinaryTree<T>::~BinaryTree() {
+template <class T, class Nodes>
+BinaryTree<T, Nodes>::~BinaryTree() {
 	clear();
 }
 
 // Pre Condition: none
 // PostCondition: element e is inserted into the tree
-template <class T>
-void BinaryTree<T>::insert(const T & e) {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::insert(const T & e) {
 	root = insert(e, root);
 	tsize++;
 }
 
 // Pre Condition: none
-// PostCondition: the contents of the tree are deleted
-template <class T>
-void BinaryTree<T>::clear() {
-	clear(root);
+// PostCondition: the contents of the tree are deleted, all nodes released together
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::clear() {
+	if (!nodes.discardIsTrivial()) {
+		discard(root);
+	}
+	nodes.reset();
 	root = nullptr;
 	tsize = 0;
 }
@@ -104,43 +114,43 @@ void BinaryTree<T>::clear() {
 // Pre Condition: none
 // PostCondition: the element e is deleted from the tree if contained in the tree
 //                otherwise the tree is unchanged
-template <class T>
-void BinaryTree<T>::remove(const T & e) {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::remove(const T & e) {
 	root = remove(e, root);
 	tsize--;
 }
 
 // Pre Condition: none
 // PostCondition: returns boolean result of searching for the element e in the tree
-template <class T>
-bool BinaryTree<T>::find(const T & e) const {
+template <class T, class Nodes>
+bool BinaryTree<T, Nodes>::find(const T & e) const {
 	return find(e, root);
 }
 
 
 // Pre Condition: none
 // PostCondition: returns true if the tree is empty and false otherwise
-template <class T>
-bool BinaryTree<T>::isEmpty() const {
+template <class T, class Nodes>
+bool BinaryTree<T, Nodes>::isEmpty() const {
 	return (root == nullptr);
 }
 
 // Pre Condition: none
 // PostCondition: print elements of tree in sorted order
-template <class T>
-void BinaryTree<T>::displayInOrder(std::ostream & os) const {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::displayInOrder(std::ostream & os) const {
 	os << "[ ";
 	displayInOrder(root, os);
 	os << "]";
 }
-template <class T>
-void BinaryTree<T>::displayPreOrder(std::ostream & os) const {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::displayPreOrder(std::ostream & os) const {
 	os << "[ ";
 	displayPreOrder(root, os);
 	os << "]";
 }
-template <class T>
-void BinaryTree<T>::displayPostOrder(std::ostream & os) const {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::displayPostOrder(std::ostream & os) const {
 	os << "[ ";
 	displayPostOrder(root, os);
 	os << "]";
@@ -148,22 +158,22 @@ void BinaryTree<T>::displayPostOrder(std::ostream & os) const {
 
 // Pre Condition: none
 // PostCondition: return the number of elements contained in the tree
-template <class T>
-int BinaryTree<T>::size() const {
+template <class T, class Nodes>
+int BinaryTree<T, Nodes>::size() const {
 	return tsize;
 }
 
 // Pre Condition: none
 // PostCondition: return the number of levels in the tree	
-template <class T>
-int BinaryTree<T>::height() const {
+template <class T, class Nodes>
+int BinaryTree<T, Nodes>::height() const {
 	return subTreeHeight(root);
 }
 
 // Pre Condition: none
 // PostCondition: creates and returns a copy of the tree rhs
-template <class T>
-const BinaryTree<T>& BinaryTree<T>::operator=(const BinaryTree<T>& rhs) {
+template <class T, class Nodes>
+const BinaryTree<T, Nodes>& BinaryTree<T, Nodes>::operator=(const BinaryTree<T, Nodes>& rhs) {
 	if (this != &rhs) {
 		clear();
 		root = copy(rhs.root);
@@ -178,8 +188,8 @@ const BinaryTree<T>& BinaryTree<T>::operator=(const BinaryTree<T>& rhs) {
 
 // Pre Condition: none
 // PostCondition: return height of tree whose root is 'n' 	
-template <class T>
-int BinaryTree<T>::subTreeHeight(BinNode<T>* n) const {
+template <class T, class Nodes>
+int BinaryTree<T, Nodes>::subTreeHeight(BinNode<T>* n) const {
 	if (n == nullptr) {
 		return 0;
 	}
@@ -197,16 +207,15 @@ int BinaryTree<T>::subTreeHeight(BinNode<T>* n) const {
 
 // Pre Condition: none
 // PostCondition: return reference to root of copy of tree whose root is 'n'
-template <class T>
-BinNode<T>* BinaryTree<T>::copy(BinNode<T>* n) {
+template <class T, class Nodes>
+BinNode<T>* BinaryTree<T, Nodes>::copy(BinNode<T>* n) {
 	BinNode<T>* t;
 	if (n == nullptr) {
 		t = nullptr;
 	}
 	else {
 		// t = new BinNode<T>(n->data, copy(n->left), copy(n->right);
-		t = new BinNode<T>();
-		t->data = n->data;
+		t = nodes.create(n->data);
 		t->left = copy(n->left);
 		t->right = copy(n->right);
 	}
@@ -215,22 +224,21 @@ BinNode<T>* BinaryTree<T>::copy(BinNode<T>* n) {
 
 
 // Pre Condition: none
-// PostCondition: delete elements from tree whose root is 'n'
-template <class T>
-void BinaryTree<T>::clear(BinNode<T>* n) {
+// PostCondition: destruct nodes of tree whose root is 'n', ready for the pool to be reset
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::discard(BinNode<T>* n) {
 	if (n != nullptr) {
-		clear(n->left);
-		clear(n->right);
-		delete n;
-		n = nullptr; // just to be sure!!
+		discard(n->left);
+		discard(n->right);
+		nodes.discard(n);
 	}
 }
 
 
 // Pre Condition: none
 // PostCondition: return reference to node containing smallest element in tree whose root is 'n'
-template <class T>
-BinNode<T>* BinaryTree<T>::findMin(BinNode<T>* n) const {
+template <class T, class Nodes>
+BinNode<T>* BinaryTree<T, Nodes>::findMin(BinNode<T>* n) const {
 	if (n == nullptr) {
 		return nullptr;
 	}
@@ -245,24 +253,24 @@ BinNode<T>* BinaryTree<T>::findMin(BinNode<T>* n) const {
 
 // Pre Condition: none
 // PostCondition: print contents of tree on stdout in sorted order
-template <class T>
-void BinaryTree<T>::displayInOrder(BinNode<T>* n, std::ostream & os) const {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::displayInOrder(BinNode<T>* n, std::ostream & os) const {
 	if (n != nullptr) {
 		displayInOrder(n->left, os);
 		os << n->data << " ";
 		displayInOrder(n->right, os);
 	}
 }
-template <class T>
-void BinaryTree<T>::displayPreOrder(BinNode<T>* n, std::ostream & os) const {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::displayPreOrder(BinNode<T>* n, std::ostream & os) const {
 	if (n != nullptr) {
 		os << n->data << " ";
 		displayPreOrder(n->left, os);
 		displayPreOrder(n->right, os);
 	}
 }
-template <class T>
-void BinaryTree<T>::displayPostOrder(BinNode<T>* n, std::ostream & os) const {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::displayPostOrder(BinNode<T>* n, std::ostream & os) const {
 	if (n != nullptr) {
 		displayPostOrder(n->left, os);
 		displayPostOrder(n->right, os);
@@ -272,10 +280,10 @@ void BinaryTree<T>::displayPostOrder(BinNode<T>* n, std::ostream & os) const {
 
 // Pre Condition: none
 // PostCondition: return reference to tree updated by inserting element 'e' into tree whose root is 'n'
-template <class T>
-BinNode<T>* BinaryTree<T>::insert(const T & e, BinNode<T>* n) {
+template <class T, class Nodes>
+BinNode<T>* BinaryTree<T, Nodes>::insert(const T & e, BinNode<T>* n) {
 	if (n == nullptr) {
-		n = new BinNode<T>(e, nullptr, nullptr);
+		n = nodes.create(e, nullptr, nullptr);
 	}
 	else if (e < n->data) {
 		n->left = insert(e, n->left);
@@ -289,8 +297,8 @@ BinNode<T>* BinaryTree<T>::insert(const T & e, BinNode<T>* n) {
 
 // Pre Condition: none
 // PostCondition: return reference to tree updated by removing element 'e' from tree whose root is 'n'
-template <class T>
-BinNode<T>* BinaryTree<T>::remove(const T & e, BinNode<T>* n) {
+template <class T, class Nodes>
+BinNode<T>* BinaryTree<T, Nodes>::remove(const T & e, BinNode<T>* n) {
 	BinNode<T> *tmp = n;
 	if (n == nullptr) {
 		return n;
@@ -308,11 +316,11 @@ BinNode<T>* BinaryTree<T>::remove(const T & e, BinNode<T>* n) {
 	}
 	else if (n->left == nullptr) {
 		n = n->right;
-		delete tmp;
+		nodes.destroy(tmp);
 	}
 	else {
 		n = n->left;
-		delete tmp;
+		nodes.destroy(tmp);
 	}
 	return n;
 }
@@ -320,8 +328,8 @@ BinNode<T>* BinaryTree<T>::remove(const T & e, BinNode<T>* n) {
 
 // Pre Condition: none
 // PostCondition: return true if element 'e' is found in tree whose root is 'n', false otherwise
-template <class T>
-bool BinaryTree<T>::find(const T & e, BinNode<T>* n) const {
+template <class T, class Nodes>
+bool BinaryTree<T, Nodes>::find(const T & e, BinNode<T>* n) const {
 	/* if (n == nullptr) {
 	return false;
 	} else if (e == n->data) {
@@ -343,8 +351,8 @@ bool BinaryTree<T>::find(const T & e, BinNode<T>* n) const {
 	return false;
 }
 
-template <class T>
-void BinaryTree<T>::load(const std::string & fname) {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::load(const std::string & fname) {
 	std::ifstream in_stream;
 	in_stream.open(fname.c_str());
 
@@ -359,21 +367,21 @@ void BinaryTree<T>::load(const std::string & fname) {
 	}
 }
 
-template <class T>
-void BinaryTree<T>::loadFrom(const Array<T> & a) {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::loadFrom(const Array<T> & a) {
 	clear();
 	for (int i = 0; i<a.length(); i++)
 		insert(a[i]);
 }
 
-template <class T>
-void BinaryTree<T>::extractTo(Array<T> & a) {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::extractTo(Array<T> & a) {
 	int start = 0;
 	extractTo(a, start, root);
 }
 
-template <class T>
-void BinaryTree<T>::extractTo(Array<T> & a, int & pos, BinNode<T>* n) {
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::extractTo(Array<T> & a, int & pos, BinNode<T>* n) const {
 	if (n != nullptr) {
 		extractTo(a, pos, n->left);
 		a[pos++] = n->data;
@@ -381,5 +389,49 @@ void BinaryTree<T>::extractTo(Array<T> & a, int & pos, BinNode<T>* n) {
 	}
 }
 
+// Pre Condition: none
+// PostCondition: size and elements written to snapshot in sorted order
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::writeTo(SnapshotWriter & w) const {
+	Array<T> a(tsize);
+	int pos = 0;
+	extractTo(a, pos, root);
+
+	w.writeTag("BTRE");
+	w.writeCount(tsize);
+	writeValues(w, a.data(), tsize);
+}
+
+// Pre Condition: next container in snapshot is a BinaryTree
+// PostCondition: tree replaced by a balanced tree of the elements read from snapshot
+template <class T, class Nodes>
+void BinaryTree<T, Nodes>::readFrom(SnapshotReader & r) {
+	r.readTag("BTRE");
+	int n = r.readCount();
+	Array<T> a(n);
+	readValues(r, a.data(), n);
+
+	clear();
+	root = buildBalanced(a, 0, n - 1);
+	tsize = n;
+}
+
+// Pre Condition: a[low..high] is sorted
+// PostCondition: return root of balanced tree holding a[low..high]. The root is the
+//                first of any run of equal middle elements, so equal elements stay
+//                on the right as insert would place them
+template <class T, class Nodes>
+BinNode<T>* BinaryTree<T, Nodes>::buildBalanced(const Array<T> & a, int low, int high) {
+	if (low > high) {
+		return nullptr;
+	}
+	int mid = (low + high) / 2;
+	while (mid > low && !(a[mid - 1] < a[mid])) {
+		mid--;
+	}
+	BinNode<T>* left = buildBalanced(a, low, mid - 1);
+	BinNode<T>* right = buildBalanced(a, mid + 1, high);
+	return nodes.create(a[mid], left, right);
+}
 
 #endif /*BinaryTree_H_*/
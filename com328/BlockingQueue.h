@@ -0,0 +1,207 @@
+/**
+ * BlockingQueue.h
+ *
+ * Thread safe Queue, based on ArrayQueue, whose put and take wait on a
+ * condition variable, optionally with a timeout. Producers are held back
+ * by high and low watermarks: once the queue holds high elements put waits
+ * until consumers have brought it down to low, so a burst is absorbed
+ * without waking producers for every element taken. drainTo empties up to
+ * max elements under a single acquisition of the lock.
+ *
+ * close() shuts the queue down: put then fails at once, and take returns
+ * the elements still queued before failing, so consumers can finish.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.0
+ */
+
+#ifndef BLOCKINGQUEUE_H_
+#define BLOCKINGQUEUE_H_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include "ArrayQueue.h"
+#include "ArrayList.h"
+
+template <class T>
+class BlockingQueue {
+public:
+	explicit BlockingQueue(int high=100, int low=-1);
+	BlockingQueue(const BlockingQueue &) = delete;
+	BlockingQueue & operator=(const BlockingQueue &) = delete;
+
+	bool put(const T & x);
+	bool put(const T & x, std::chrono::milliseconds timeout);
+	bool take(T & x);
+	bool take(T & x, std::chrono::milliseconds timeout);
+	int  drainTo(ArrayList<T> & items, int max);
+	void close();
+
+	bool isClosed() const;
+	bool isEmpty() const;
+	int  size() const;
+	int  highWatermark() const	{ return high; }
+	int  lowWatermark() const	{ return low; }
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	bool putUntil(const T & x, const Clock::time_point * deadline);
+	bool takeUntil(T & x, const Clock::time_point * deadline);
+	void taken(std::unique_lock<std::mutex> & hold);
+
+	mutable std::mutex lock;
+	std::condition_variable notEmpty;	// signalled on put and close
+	std::condition_variable notFull;	// signalled when the queue falls to low, and on close
+	Queue<T> elements;
+	int  high;
+	int  low;
+	bool throttled;						// reached high, producers wait until low
+	bool closed;
+};
+
+// ========================= IMPLEMENTATION BlockingQueue.cpp ===================================
+
+// PreCondition: 0 <= low < high, a negative low defaults to high / 2
+// PostCondition: empty open queue holding at most high elements
+template <class T>
+BlockingQueue<T>::BlockingQueue(int high, int low)
+	: elements(high), high(high), low(low < 0 ? high / 2 : low), throttled(false), closed(false) {
+	if (high < 1 || this->low >= high) {
+		throw std::invalid_argument("BlockingQueue watermarks need 0 <= low < high");
+	}
+}
+
+// PostCondition: x added to end of the queue, waiting while producers are held back.
+//                Returns false, without adding x, if the queue is closed
+template <class T>
+bool BlockingQueue<T>::put(const T & x) {
+	return putUntil(x, nullptr);
+}
+
+// PostCondition: as put, but returns false if x could not be added within timeout
+template <class T>
+bool BlockingQueue<T>::put(const T & x, std::chrono::milliseconds timeout) {
+	Clock::time_point deadline = Clock::now() + timeout;
+	return putUntil(x, &deadline);
+}
+
+// PostCondition: least recently inserted element moved to x and removed, waiting for one
+//                if empty. Returns false once the queue is closed and empty
+template <class T>
+bool BlockingQueue<T>::take(T & x) {
+	return takeUntil(x, nullptr);
+}
+
+// PostCondition: as take, but returns false if no element arrived within timeout
+template <class T>
+bool BlockingQueue<T>::take(T & x, std::chrono::milliseconds timeout) {
+	Clock::time_point deadline = Clock::now() + timeout;
+	return takeUntil(x, &deadline);
+}
+
+// PostCondition: up to max elements appended to items in order and removed, under one
+//                acquisition of the lock and without waiting. Returns the number moved
+template <class T>
+int BlockingQueue<T>::drainTo(ArrayList<T> & items, int max) {
+	std::unique_lock<std::mutex> hold(lock);
+	int n = std::max(0, std::min(max, elements.size()));
+	items.reserve(items.size() + n);
+	for (int i = 0; i < n; i++) {
+		items.add(elements.peek());
+		elements.dequeue();
+	}
+	if (n > 0) {
+		taken(hold);
+	}
+	return n;
+}
+
+// PostCondition: queue closed, every waiting producer and consumer woken
+template <class T>
+void BlockingQueue<T>::close() {
+	{
+		std::lock_guard<std::mutex> hold(lock);
+		closed = true;
+	}
+	notEmpty.notify_all();
+	notFull.notify_all();
+}
+
+template <class T>
+bool BlockingQueue<T>::isClosed() const {
+	std::lock_guard<std::mutex> hold(lock);
+	return closed;
+}
+
+template <class T>
+bool BlockingQueue<T>::isEmpty() const {
+	return size() == 0;
+}
+
+// PostCondition: return number of elements in the queue
+template <class T>
+int BlockingQueue<T>::size() const {
+	std::lock_guard<std::mutex> hold(lock);
+	return elements.size();
+}
+
+// PostCondition: x added unless the queue closed or, when deadline is given, it passed
+//                while producers were held back
+template <class T>
+bool BlockingQueue<T>::putUntil(const T & x, const Clock::time_point * deadline) {
+	std::unique_lock<std::mutex> hold(lock);
+	auto ready = [this]() { return closed || !throttled; };
+	if (deadline == nullptr) {
+		notFull.wait(hold, ready);
+	} else if (!notFull.wait_until(hold, *deadline, ready)) {
+		return false;
+	}
+	if (closed) {
+		return false;
+	}
+	elements.enqueue(x);
+	if (elements.size() == high) {
+		throttled = true;
+	}
+	hold.unlock();
+	notEmpty.notify_one();
+	return true;
+}
+
+// PostCondition: element taken into x unless the queue is closed and empty or, when
+//                deadline is given, it passed with the queue empty
+template <class T>
+bool BlockingQueue<T>::takeUntil(T & x, const Clock::time_point * deadline) {
+	std::unique_lock<std::mutex> hold(lock);
+	auto ready = [this]() { return closed || !elements.isEmpty(); };
+	if (deadline == nullptr) {
+		notEmpty.wait(hold, ready);
+	} else if (!notEmpty.wait_until(hold, *deadline, ready)) {
+		return false;
+	}
+	if (elements.isEmpty()) {
+		return false;				// closed and drained
+	}
+	x = elements.peek();
+	elements.dequeue();
+	taken(hold);
+	return true;
+}
+
+// PreCondition: hold owns the lock and elements have just been removed
+// PostCondition: producers released, and the lock given up, once the queue is down to low
+template <class T>
+void BlockingQueue<T>::taken(std::unique_lock<std::mutex> & hold) {
+	if (throttled && elements.size() <= low) {
+		throttled = false;
+		hold.unlock();
+		notFull.notify_all();
+	}
+}
+
+#endif
@@ -0,0 +1,202 @@
+/***********************************************************************
+ * Name        : ConcurrentLinkedList.h
+ * Author      : a.mccaughey@ulster.ac.uk
+ * Version     : 1.0
+ * Description : Lock free sorted set as a singly linked list with a dummy
+ *               header (Harris, with Michael's single node unlinking).
+ *               remove marks the next link of a node to delete it
+ *               logically, so no insert can follow it, and the node is
+ *               then unlinked by whichever thread next passes it. Unlinked
+ *               nodes are freed through EpochReclaimer. add, remove and
+ *               contains may be called from any number of threads.
+ ***********************************************************************/
+
+#ifndef CONCURRENTLINKEDLIST_H
+#define CONCURRENTLINKEDLIST_H
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include "EpochReclaimer.h"
+
+// =============================== LIST CNode =============================================
+// Node of a ConcurrentLinkedList, the low bit of next is set once the node is deleted
+template <class T>
+struct CNode {
+	CNode(const T& d = T(), CNode<T>* n = nullptr) : data(d), next(reinterpret_cast<std::uintptr_t>(n)) { }
+
+	static CNode<T>* ptr(std::uintptr_t link)	{ return reinterpret_cast<CNode<T>*>(link & ~std::uintptr_t(1)); }
+	static bool marked(std::uintptr_t link)		{ return (link & 1) != 0; }
+
+	const T data;
+	std::atomic<std::uintptr_t> next;
+};
+
+// ========================== CONCURRENT LINKED LIST =======================================
+template <class T>
+class ConcurrentLinkedList {
+public:
+	ConcurrentLinkedList();
+	virtual ~ConcurrentLinkedList();
+	ConcurrentLinkedList(const ConcurrentLinkedList &) = delete;
+	ConcurrentLinkedList & operator=(const ConcurrentLinkedList &) = delete;
+
+	bool add(const T & value);
+	bool remove(const T & value);
+	bool contains(const T & value) const;
+	int  size() const;
+	bool isEmpty() const;
+
+	void print(std::ostream & os) const;
+
+private:
+	bool locate(const T & value, CNode<T>* & pred, CNode<T>* & curr);
+
+	CNode<T> *header;
+	std::atomic<int> count;
+};
+
+// ============================== ConcurrentLinkedList Implementation ======================
+
+// Default Constructor
+template <class T>
+ConcurrentLinkedList<T>::ConcurrentLinkedList() : header(new CNode<T>()), count(0) {}
+
+// PreCondition: no other thread is using the list
+// PostCondition: every node still linked released, unlinked ones are left to EpochReclaimer
+template <class T>
+ConcurrentLinkedList<T>::~ConcurrentLinkedList() {
+	CNode<T>* n = header;
+	while (n != nullptr) {
+		CNode<T>* d = n;
+		n = CNode<T>::ptr(n->next.load(std::memory_order_relaxed));
+		delete d;
+	}
+}
+
+// PreCondition: calling thread is inside an EpochReclaimer::Guard
+// PostCondition: pred is the last node with data < value and curr its successor (nullptr
+//                at the end), both unmarked when seen. Marked nodes passed are unlinked
+//                and retired. Returns true if curr holds value
+template <class T>
+bool ConcurrentLinkedList<T>::locate(const T & value, CNode<T>* & pred, CNode<T>* & curr) {
+retry:
+	pred = header;
+	curr = CNode<T>::ptr(pred->next.load(std::memory_order_acquire));
+	while (curr != nullptr) {
+		std::uintptr_t succ = curr->next.load(std::memory_order_acquire);
+		if (CNode<T>::marked(succ)) {
+			// curr is deleted - unlink it, or start again if pred changed or was deleted
+			std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(curr);
+			if (!pred->next.compare_exchange_strong(expected, succ & ~std::uintptr_t(1))) {
+				goto retry;
+			}
+			EpochReclaimer::retire(curr);
+			curr = CNode<T>::ptr(succ);
+		} else if (curr->data < value) {
+			pred = curr;
+			curr = CNode<T>::ptr(succ);
+		} else {
+			return curr->data == value;
+		}
+	}
+	return false;
+}
+
+// PostCondition: inserts value in order and returns true, or returns false if present
+template <class T>
+bool ConcurrentLinkedList<T>::add(const T & value) {
+	EpochReclaimer::Guard guard;
+	CNode<T>* n = nullptr;
+	CNode<T> *pred, *curr;
+	for (;;) {
+		if (locate(value, pred, curr)) {
+			delete n;					// never published
+			return false;
+		}
+		if (n == nullptr) {
+			n = new CNode<T>(value, curr);
+		} else {
+			n->next.store(reinterpret_cast<std::uintptr_t>(curr), std::memory_order_relaxed);
+		}
+		std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(curr);
+		if (pred->next.compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(n))) {
+			count++;
+			return true;
+		}
+	}
+}
+
+// PostCondition: removes value and returns true, or returns false if not present. The
+//                thread whose mark succeeds removes it, the node is unlinked here or by
+//                the next thread to pass it
+template <class T>
+bool ConcurrentLinkedList<T>::remove(const T & value) {
+	EpochReclaimer::Guard guard;
+	CNode<T> *pred, *curr;
+	for (;;) {
+		if (!locate(value, pred, curr)) {
+			return false;
+		}
+		std::uintptr_t succ = curr->next.load(std::memory_order_acquire);
+		if (CNode<T>::marked(succ) || !curr->next.compare_exchange_strong(succ, succ | 1)) {
+			continue;					// removed or successor changed, look again
+		}
+		count--;
+		std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(curr);
+		if (pred->next.compare_exchange_strong(expected, succ)) {
+			EpochReclaimer::retire(curr);
+		} else {
+			locate(value, pred, curr);	// unlinks curr
+		}
+		return true;
+	}
+}
+
+// PostCondition: returns true if value is present, without writing to the list
+template <class T>
+bool ConcurrentLinkedList<T>::contains(const T & value) const {
+	EpochReclaimer::Guard guard;
+	CNode<T>* curr = CNode<T>::ptr(header->next.load(std::memory_order_acquire));
+	while (curr != nullptr && curr->data < value) {
+		curr = CNode<T>::ptr(curr->next.load(std::memory_order_acquire));
+	}
+	return curr != nullptr && curr->data == value && !CNode<T>::marked(curr->next.load(std::memory_order_acquire));
+}
+
+// PostCondition: returns number of elements, exact only while no thread is updating
+template <class T>
+int ConcurrentLinkedList<T>::size() const {
+	return count.load();
+}
+
+template <class T>
+bool ConcurrentLinkedList<T>::isEmpty() const {
+	return size() == 0;
+}
+
+// PostCondition: prints elements present during the traversal to output stream
+template <class T>
+void ConcurrentLinkedList<T>::print(std::ostream & os) const {
+	EpochReclaimer::Guard guard;
+	os << "[ ";
+	CNode<T>* curr = CNode<T>::ptr(header->next.load(std::memory_order_acquire));
+	while (curr != nullptr) {
+		std::uintptr_t succ = curr->next.load(std::memory_order_acquire);
+		if (!CNode<T>::marked(succ)) {
+			os << curr->data << " ";
+		}
+		curr = CNode<T>::ptr(succ);
+	}
+	os << "]";
+}
+
+// PreCondition: None
+// PostCondition: overload << operator to output ConcurrentLinkedList on ostream
+template <class T>
+std::ostream& operator <<(std::ostream& output, const ConcurrentLinkedList<T>& l) {
+	l.print(output);
+	return output;
+}
+
+#endif /*CONCURRENTLINKEDLIST_H*/
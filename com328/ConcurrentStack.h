@@ -0,0 +1,202 @@
+/**
+ * ConcurrentStack.h
+ *
+ * Lock free Stack (Treiber) of LinkedList Nodes. push links a new node in
+ * front of the top and pop unlinks the top, each with a single CAS of top.
+ * A node's next is set before the node is published and never changed, so
+ * it needs no atomic access.
+ *
+ * Popped nodes are freed through EpochReclaimer, which also rules out ABA:
+ * a pop compares top with the node it read, and as that node cannot be freed
+ * while the pop is inside its guard, its address cannot be reused for a new
+ * node that the CAS would mistake for it.
+ *
+ * Under heavy contention a failed CAS can fall back to an elimination array
+ * (Hendler, Shavit and Yerushalmi): a push offers its node in a random slot
+ * for a moment, and a pop finding it there takes it, so the pair completes
+ * without touching top at all.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.1
+ */
+
+#ifndef CONCURRENTSTACK_H_
+#define CONCURRENTSTACK_H_
+
+#include <atomic>
+#include <cstdint>
+#include "EpochReclaimer.h"
+#include "LinkedList.h"
+#include "AlignedArray.h"
+
+template <class T>
+class ConcurrentStack {
+public:
+	static const int OFFER_SPINS = 64;		// checks a push makes for a pop taking its offer
+
+	explicit ConcurrentStack(int eliminationSlots=0);
+	virtual ~ConcurrentStack();
+	ConcurrentStack(const ConcurrentStack &) = delete;
+	ConcurrentStack & operator=(const ConcurrentStack &) = delete;
+
+	void push(const T & element);
+	bool pop(T & element);
+	bool isEmpty() const;
+
+private:
+	// slot of the elimination array, on a cache line of its own
+	struct alignas(CACHE_LINE) Exchanger {
+		std::atomic<Node<T>*> offer;		// nullptr, a pushed node, or taken
+	};
+
+	bool tryPush(Node<T>* n);
+	bool tryPop(Node<T>* & n);
+	bool offer(Node<T>* n);
+	Node<T>* accept();
+	Exchanger & randomSlot();
+
+	static Node<T>* taken()		{ static char mark; return reinterpret_cast<Node<T>*>(&mark); }	// never a node
+
+	Exchanger *slots;		// cache line aligned, see AlignedSlots
+	int nslots;
+
+	alignas(CACHE_LINE) std::atomic<Node<T>*> top;	// on a cache line of its own
+};
+
+// ========================= IMPLEMENTATION ConcurrentStack.cpp ===================================
+
+// PostCondition: empty stack, with an elimination array when eliminationSlots > 0. The
+//                array is allocated by hand as new does not align Exchanger before C++17
+template <class T>
+ConcurrentStack<T>::ConcurrentStack(int eliminationSlots)
+	: slots(AlignedSlots<Exchanger>::allocateSlots(eliminationSlots)), nslots(eliminationSlots), top(nullptr) {
+	for (int i = 0; i < nslots; i++) {
+		new (slots + i) Exchanger();
+		slots[i].offer.store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+// PreCondition: no other thread is using the stack
+// PostCondition: remaining nodes released
+template <class T>
+ConcurrentStack<T>::~ConcurrentStack() {
+	Node<T>* n = top.load(std::memory_order_relaxed);
+	while (n != nullptr) {
+		Node<T>* d = n;
+		n = n->next;
+		delete d;
+	}
+	for (int i = 0; i < nslots; i++) {
+		slots[i].~Exchanger();
+	}
+	AlignedSlots<Exchanger>::freeSlots(slots);
+}
+
+// PostCondition: element added to top of stack
+template <class T>
+void ConcurrentStack<T>::push(const T & element) {
+	Node<T>* n = new Node<T>(element);
+	while (!tryPush(n)) {
+		if (nslots > 0 && offer(n)) {
+			return;					// handed straight to a pop
+		}
+	}
+}
+
+// PostCondition: top element moved to element, removed and true returned, or false if empty
+template <class T>
+bool ConcurrentStack<T>::pop(T & element) {
+	EpochReclaimer::Guard guard;
+	Node<T>* n;
+	for (;;) {
+		if (tryPop(n)) {
+			if (n == nullptr) {
+				return false;
+			}
+			element = std::move(n->data);
+			EpochReclaimer::retire(n);	// other pops may still be reading n
+			return true;
+		}
+		if (nslots > 0 && (n = accept()) != nullptr) {
+			element = std::move(n->data);
+			delete n;					// never on the stack, only this pop holds it
+			return true;
+		}
+	}
+}
+
+// PostCondition: true if the stack held no elements when checked
+template <class T>
+bool ConcurrentStack<T>::isEmpty() const {
+	return top.load(std::memory_order_acquire) == nullptr;
+}
+
+// PostCondition: n linked as the top and true returned, or false if top changed meanwhile
+template <class T>
+bool ConcurrentStack<T>::tryPush(Node<T>* n) {
+	Node<T>* t = top.load(std::memory_order_relaxed);
+	n->next = t;
+	return top.compare_exchange_weak(t, n, std::memory_order_release, std::memory_order_relaxed);
+}
+
+// PreCondition: calling thread is inside an EpochReclaimer::Guard
+// PostCondition: true with n the unlinked top, or nullptr if empty, or false if top
+//                changed meanwhile
+template <class T>
+bool ConcurrentStack<T>::tryPop(Node<T>* & n) {
+	n = top.load(std::memory_order_acquire);
+	if (n == nullptr) {
+		return true;
+	}
+	return top.compare_exchange_weak(n, n->next, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+// PostCondition: n offered in a random free slot, returns true if a pop took it, false
+//                (n withdrawn) if none did, or the slot was in use
+template <class T>
+bool ConcurrentStack<T>::offer(Node<T>* n) {
+	Exchanger & slot = randomSlot();
+	Node<T>* empty = nullptr;
+	if (!slot.offer.compare_exchange_strong(empty, n, std::memory_order_release, std::memory_order_relaxed)) {
+		return false;
+	}
+	for (int i = 0; i < OFFER_SPINS; i++) {
+		if (slot.offer.load(std::memory_order_acquire) == taken()) {
+			break;
+		}
+	}
+	Node<T>* mine = n;
+	if (slot.offer.compare_exchange_strong(mine, nullptr, std::memory_order_acquire, std::memory_order_acquire)) {
+		return false;				// withdrawn untaken
+	}
+	slot.offer.store(nullptr, std::memory_order_release);	// taken - free the slot again
+	return true;
+}
+
+// PostCondition: returns node taken from a random slot holding an offer, or nullptr
+template <class T>
+Node<T>* ConcurrentStack<T>::accept() {
+	Exchanger & slot = randomSlot();
+	Node<T>* n = slot.offer.load(std::memory_order_acquire);
+	if (n == nullptr || n == taken() || !slot.offer.compare_exchange_strong(n, taken(), std::memory_order_acquire, std::memory_order_relaxed)) {
+		return nullptr;
+	}
+	return n;
+}
+
+// PostCondition: returns a slot of the elimination array picked by a per thread xorshift,
+//                seeded from the address of its state so threads pick different slots
+template <class T>
+typename ConcurrentStack<T>::Exchanger & ConcurrentStack<T>::randomSlot() {
+	static thread_local unsigned seed = 0;
+	if (seed == 0) {
+		seed = (unsigned)(reinterpret_cast<std::uintptr_t>(&seed) >> 4) | 1;
+	}
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return slots[seed % nslots];
+}
+
+#endif
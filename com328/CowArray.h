@@ -0,0 +1,191 @@
+/**
+ * CowArray.h
+ *
+ * Copy on write Array. Copies share one reference counted Array, so taking
+ * a copy is O(1); the first non-const access to a shared copy pays for the
+ * deep copy. Used as the Storage of an ArrayList (CowArrayList) to make
+ * snapshots of lists and databases cheap.
+ *
+ * A reference, pointer or view obtained through a non-const access refers
+ * to the copy it was obtained from; copies taken after that point share
+ * those elements until one of them is written through a non-const access.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.0
+ */
+
+#ifndef COWARRAY_H_
+#define COWARRAY_H_
+
+#include <memory>
+#include "Array.h"
+#include "ArrayList.h"
+
+template <class T, class Bounds = CheckedBounds>
+class CowArray
+{
+public:
+	explicit CowArray(int size=0);
+	CowArray(const Array<T, Bounds> & a);
+
+	const T& operator[](int index) const;
+	T&       operator[](int index);
+	const T& unchecked_at(int index) const;
+	T&       unchecked_at(int index);
+	const T* data() const;
+	T*       data();
+	int  length() const;
+	int  capacity() const;
+	bool isShared() const;
+
+	void resize(int newSize);
+	void reserve(int newCapacity);
+	void initialise(T def=T());
+	void print(std::ostream & os=std::cout) const;
+	std::string toString() const;
+
+	void writeTo(SnapshotWriter & w) const;
+	void readFrom(SnapshotReader & r);
+
+private:
+	std::shared_ptr< Array<T, Bounds> > shared;
+
+	Array<T, Bounds> & unshare();
+};
+
+// ArrayList whose copies share storage until one of them is modified
+template <class T, class Bounds = CheckedBounds>
+using CowArrayList = ArrayList<T, Bounds, CowArray<T, Bounds> >;
+
+// ========================= IMPLEMENTATION CowArray.cpp ===================================
+
+// PreCondition: None
+// PostCondition: creates an unshared array of specified size
+template <class T, class Bounds>
+CowArray<T, Bounds>::CowArray(int size) : shared(std::make_shared< Array<T, Bounds> >(size)) {}
+
+// PostCondition: creates an unshared copy of a
+template <class T, class Bounds>
+CowArray<T, Bounds>::CowArray(const Array<T, Bounds> & a) : shared(std::make_shared< Array<T, Bounds> >(a)) {}
+
+// PostCondition: read only access to element at index, never copies
+template <class T, class Bounds>
+inline const T& CowArray<T, Bounds>::operator[](int index) const
+{
+	return (*shared)[index];
+}
+
+// PostCondition: writable access to element at index, copies the elements first if shared
+template <class T, class Bounds>
+inline T& CowArray<T, Bounds>::operator[](int index)
+{
+	return unshare()[index];
+}
+
+template <class T, class Bounds>
+inline const T& CowArray<T, Bounds>::unchecked_at(int index) const
+{
+	return shared->unchecked_at(index);
+}
+
+template <class T, class Bounds>
+inline T& CowArray<T, Bounds>::unchecked_at(int index)
+{
+	return unshare().unchecked_at(index);
+}
+
+template <class T, class Bounds>
+inline const T* CowArray<T, Bounds>::data() const
+{
+	return shared->data();
+}
+
+template <class T, class Bounds>
+inline T* CowArray<T, Bounds>::data()
+{
+	return unshare().data();
+}
+
+template <class T, class Bounds>
+inline int CowArray<T, Bounds>::length() const
+{
+	return shared->length();
+}
+
+template <class T, class Bounds>
+inline int CowArray<T, Bounds>::capacity() const
+{
+	return shared->capacity();
+}
+
+// PostCondition: returns true if the elements are shared with another copy
+template <class T, class Bounds>
+bool CowArray<T, Bounds>::isShared() const
+{
+	return shared.use_count() > 1;
+}
+
+template <class T, class Bounds>
+void CowArray<T, Bounds>::resize(int newSize)
+{
+	unshare().resize(newSize);
+}
+
+template <class T, class Bounds>
+void CowArray<T, Bounds>::reserve(int newCapacity)
+{
+	unshare().reserve(newCapacity);
+}
+
+template <class T, class Bounds>
+void CowArray<T, Bounds>::initialise(T def)
+{
+	unshare().initialise(def);
+}
+
+template <class T, class Bounds>
+void CowArray<T, Bounds>::print(std::ostream & os) const
+{
+	shared->print(os);
+}
+
+template <class T, class Bounds>
+std::string CowArray<T, Bounds>::toString() const
+{
+	return shared->toString();
+}
+
+template <class T, class Bounds>
+void CowArray<T, Bounds>::writeTo(SnapshotWriter & w) const
+{
+	shared->writeTo(w);
+}
+
+template <class T, class Bounds>
+void CowArray<T, Bounds>::readFrom(SnapshotReader & r)
+{
+	Array<T, Bounds> a;
+	a.readFrom(r);
+	shared = std::make_shared< Array<T, Bounds> >(std::move(a));
+}
+
+// PostCondition: elements are no longer shared, copied if another copy refers to them
+template <class T, class Bounds>
+Array<T, Bounds> & CowArray<T, Bounds>::unshare()
+{
+	if (shared.use_count() > 1) {
+		shared = std::make_shared< Array<T, Bounds> >(*shared);
+	}
+	return *shared;
+}
+
+// PreCondition: None
+// PostCondition: overload << operator to output array on ostream
+template <class T, class Bounds>
+std::ostream& operator <<(std::ostream& output, const CowArray<T, Bounds>& p) {
+	p.print(output);
+	return output;
+}
+
+#endif
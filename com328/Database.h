@@ -5,24 +5,27 @@
 *
 * @author  Aiden McCaughey
 * @email   a.mccaughey@ulster.ac.uk
-* @version 1.1 (12-12-2016)
+* @version 1.3
 */
 
 #ifndef DATABASE_H_
 #define DATABASE_H_
 
 #include "ArrayList.h"
+#include "CowArray.h"
 
 #include <cstdlib>
 #include <fstream>
 
-template <class T>
+// List is the ArrayList holding the records, e.g. CowArrayList<T> makes copies
+// of the database share their records until one of the copies is modified
+template <class T, class List = ArrayList<T> >
 class Database
 {
 public:
 	explicit Database(int s = 100) : elements(s), current{ -1 } {};
-	Database(const ArrayList<T> & e) : elements(e), current{ -1 } {};
-	Database(const Database<T> & d) : elements(d.elements), current{ d.current } {};
+	Database(const List & e) : elements(e), current{ -1 } {};
+	Database(const Database & d) : elements(d.elements), current{ d.current } {};
 
 	bool first();
 	bool last();
@@ -42,21 +45,21 @@ public:
 	void save(const std::string & fname);
 
 protected:
-	ArrayList<T> elements;
+	List elements;
 	int current;
 
 };
 
 // PostCondition: return number of elements database
-template <class T>
-inline int Database<T>::size() const
+template <class T, class List>
+inline int Database<T, List>::size() const
 {
 	return elements.size();
 }
 
 // PostCondition: initialise the database to empty
-template <class T>
-void Database<T>::clear()
+template <class T, class List>
+void Database<T, List>::clear()
 {
 	elements.clear();
 	current=-1;
@@ -64,8 +67,8 @@ void Database<T>::clear()
 
 // PostCondition: move to previous position in database if possible
 //                and return true otherwise false
-template <class T>
-inline bool Database<T>::prev() 
+template <class T, class List>
+inline bool Database<T, List>::prev() 
 {
 	if (size() > 0 && current > 0) {
 		current--;
@@ -77,8 +80,8 @@ inline bool Database<T>::prev()
 
 // PostCondition: move to next position in database if possible
 //                and return true otherwise false
-template <class T>
-inline bool Database<T>::next() 
+template <class T, class List>
+inline bool Database<T, List>::next() 
 {
 	if (size() > 0 && current < size()-1) {
 		current++;
@@ -90,8 +93,8 @@ inline bool Database<T>::next()
 
 // PostCondition: move to first position in database if possible
 //                and return true otherwise false
-template <class T>
-inline bool Database<T>::first() 
+template <class T, class List>
+inline bool Database<T, List>::first() 
 {
 	if (size() > 0) {
 		current=0;
@@ -103,8 +106,8 @@ inline bool Database<T>::first()
 
 // PostCondition: move to last position in database if possible
 //                and return true otherwise false
-template <class T>
-inline bool Database<T>::last() 
+template <class T, class List>
+inline bool Database<T, List>::last() 
 {
 	if (size() > 0) {
 		current = size()-1;
@@ -115,8 +118,8 @@ inline bool Database<T>::last()
 }
 
 // PostCondition: add element to current position in database
-template <class T>
-void Database<T>::add(const T & element)
+template <class T, class List>
+void Database<T, List>::add(const T & element)
 {
 	if (current >= -1 && current < size()) {
 		current++;
@@ -128,8 +131,8 @@ void Database<T>::add(const T & element)
 
 
 // PostCondition: update element at current position in database
-template <class T>
-void Database<T>::set(const T & element)
+template <class T, class List>
+void Database<T, List>::set(const T & element)
 {
 	if (current >= -1 && current < size()) {
 		elements.set(current, element);
@@ -142,8 +145,8 @@ void Database<T>::set(const T & element)
 
 // PreCondition: database is not empty
 // PostCondition: return element at current position
-template <class T>
-T Database<T>::get() const
+template <class T, class List>
+T Database<T, List>::get() const
 {
 	if (current >= 0 && current < size()) {
 		return elements.get(current);
@@ -156,8 +159,8 @@ T Database<T>::get() const
 // PreCondition: database is not empty
 // PostCondition: element at current position is deleted and 
 //                current is decremented when current is > 0 
-template <class T>
-void Database<T>::remove()
+template <class T, class List>
+void Database<T, List>::remove()
 {
 	if (current >= 0 && current < size()) {
 		elements.remove(current);
@@ -170,8 +173,8 @@ void Database<T>::remove()
 
 // PreCondition:  type T has a copy constructor that can deserialse a string into a type T instance
 // PostCondition: load content of file into database
-template <class T>
-void Database<T>::load(const std::string & fname) {
+template <class T, class List>
+void Database<T, List>::load(const std::string & fname) {
 	std::ifstream in_stream;
 	in_stream.open(fname.c_str());
 
@@ -190,34 +193,35 @@ void Database<T>::load(const std::string & fname) {
 
 // PreCondition: type T has an overloaded << operator that can serialise an instance of T
 // PostCondition: save content of database to file
-template <class T>
-void Database<T>::save(const std::string & fname) {
+template <class T, class List>
+void Database<T, List>::save(const std::string & fname) {
 	std::ofstream out_stream;
-	int orig_current = current;
+	const List & records = elements;	// read only, so records shared by a copy are not copied
 
 	out_stream.open(fname.c_str());
-	first();
-	if (!out_stream.fail() && size() > 0) {
-		do  {
-			out_stream << get();
-			out_stream << std::endl;
-		} while (next());
+	if (!out_stream.fail()) {
+		for (const T & record : records) {
+			out_stream << record << std::endl;
+		}
 	}
-	current = orig_current;
 	out_stream.close();
 	
 }
 
 // Post Condition: Print elements in sequence to parameter ostream
-template <class T>
-void Database<T>::print(std::ostream & os) const {
+template <class T, class List>
+void Database<T, List>::print(std::ostream & os) const {
 	os << "{" << current << "} ";
 	elements.print(os);
 	os << std::endl;
 }
 
+// Database whose copies (e.g. read only snapshots) cost O(1) until modified
 template <class T>
-std::ostream& operator <<(std::ostream& output, const Database<T>& p) {
+using CowDatabase = Database<T, CowArrayList<T> >;
+
+template <class T, class List>
+std::ostream& operator <<(std::ostream& output, const Database<T, List>& p) {
 	p.print(output);
 	return output;  // for multiple << operators.
 }
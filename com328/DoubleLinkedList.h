@@ -1,9 +1,13 @@
 /**********************************************************************
  * Name        : DoubleLinkedList.h
  * Author      : a.mccaughey@ulster.ac.uk
- * Version     : 1.4
+ * Version     : 1.8
  * Description : Dynamic Doubly Linked List class with public DNode
- *               and error checking using exceptions
+ *               and error checking using exceptions. Positional
+ *               operations walk from whichever is nearest of the front,
+ *               the back and the DNode last located, so a get(i) loop is
+ *               O(n) overall. As get updates that cursor, concurrent
+ *               readers of one list are not safe
  *********************************************************************/
 
 #ifndef DOUBLELINKEDLIST_H
@@ -12,6 +16,8 @@
 #include <cstdlib> // Defines NULL
 #include <iostream>
 #include <exception>
+#include <functional>
+#include "NodePool.h"
 
 // =============================== LIST DNode ==============================================
 // DNode Class Used as Building Blocks of a Doubly Linked List
@@ -30,6 +36,7 @@ template <class T>
 class DListIterator {
 	public:
 		DListIterator(DNode<T> *start=nullptr) : current(start)	{}
+		DListIterator(const DListIterator & o) = default;
 		DListIterator & operator=(const DListIterator & o)	{ current = o.current; return (*this); }
 		T & operator*()										{ return current->data; }
 		DListIterator & operator++()						{ current = current->next; return *(this);}
@@ -39,18 +46,20 @@ class DListIterator {
 		bool operator!=(const DListIterator & o)			{ return current != o.current; }
 		bool operator==(const DListIterator & o)			{ return current == o.current; }
 	private:
+		template <class, class> friend class DLinkedList;
 		DNode<T> *current;
 };
 
 // ============================== LINKED LIST ===========================================
-template <class T>
+// Nodes selects how nodes are allocated, see NodePool.h
+template <class T, class Nodes = NodePool< DNode<T> > >
 class DLinkedList {
 public:
 	DLinkedList(int n=10);
     virtual ~DLinkedList();
-    DLinkedList(const DLinkedList<T> & c);
-	void operator=(const DLinkedList<T> & c);
-	bool operator==(const DLinkedList<T> & o) const;
+    DLinkedList(const DLinkedList & c);
+	void operator=(const DLinkedList & c);
+	bool operator==(const DLinkedList & o) const;
 	
     void clear();
 	void add(const T & value);
@@ -69,31 +78,52 @@ public:
 	DListIterator<T> begin() const	{ return DListIterator<T>(header->next); }
 	DListIterator<T> end()   const	{ return DListIterator<T>(header); }
 
+	// Iterator based editing in O(1) - relinks nodes so elements are never copied
+	DListIterator<T> insertBefore(DListIterator<T> pos, const T & value);
+	DListIterator<T> insertAfter(DListIterator<T> pos, const T & value);
+	DListIterator<T> erase(DListIterator<T> pos);
+	void splice(DListIterator<T> pos, DLinkedList & other, DListIterator<T> first, DListIterator<T> last);
+	void splice(DListIterator<T> pos, DLinkedList & other);
+
+	// Stable sorting by relinking DNodes - no allocation and no element copies
+	template <class Compare = std::less<T> >
+	void sort(Compare cmp = Compare());
+	template <class Compare = std::less<T> >
+	void merge(DLinkedList & other, Compare cmp = Compare());
+
 private:
+	template <class Compare>
+	static DNode<T> *mergeRuns(DNode<T> *a, DNode<T> *b, Compare & cmp);
+	void relink(DNode<T> *first);
     DNode<T> *DNodeAt(int pos) const;
-	void addBefore(const T & e, DNode<T> *p);
-	void deepCopy(const DLinkedList<T> & c);
+	DNode<T> *addBefore(const T & e, DNode<T> *p);
+	void deepCopy(const DLinkedList & c);
+	void resetCursor() const		{ cursor = header; cursorPos = -1; }
 
 	DNode<T> *header;
 	int		count;
+	Nodes	nodes;
+	mutable DNode<T> *cursor;	// DNode last located by DNodeAt and its position,
+	mutable int cursorPos;		// header (-1) after edits that move DNodes
 };
 
 
 // ----------------- Double LinkedList Implementation ----------------
 
 // Default Constructor
-template <class T>
-DLinkedList<T>::DLinkedList(int n) { // dummy size for compatability with ArrayList
+template <class T, class Nodes>
+DLinkedList<T, Nodes>::DLinkedList(int n) { // dummy size for compatability with ArrayList
 	header = new DNode<T>();
   	header->prev = header;	
   	header->next = header;
 	count = 0;
+	resetCursor();
 }
 
 
 // Destructor
-template <class T>
-DLinkedList<T>::~DLinkedList() {
+template <class T, class Nodes>
+DLinkedList<T, Nodes>::~DLinkedList() {
 	clear();		// delete DNodes
 	delete header;	// delete header
 }
@@ -101,35 +131,36 @@ DLinkedList<T>::~DLinkedList() {
 
 // PreCondition: c is not null
 // PostCondition: copy constructor
-template <class T>
-DLinkedList<T>::DLinkedList(const DLinkedList& c) {
+template <class T, class Nodes>
+DLinkedList<T, Nodes>::DLinkedList(const DLinkedList<T, Nodes> & c) {
     // initialise the header DNode
     header = new DNode<T>;
 	header->prev = header;	
   	header->next = header;
 	count = 0;
+	resetCursor();
 	deepCopy(c);
 }
 
 
 // PreCondition: c is not null
 // PostCondition: overloaded assignment operator
-template <class T>
-void DLinkedList<T>::operator=(const DLinkedList<T> & c) {
+template <class T, class Nodes>
+void DLinkedList<T, Nodes>::operator=(const DLinkedList<T, Nodes> & c) {
 	clear();		// clear existing DLinkedList
 	deepCopy(c);	// perform a deep copy
 }
 
 // PostCondition: test DLinkedLists for equality
-template<class T>
-bool DLinkedList<T>::operator==(const DLinkedList<T> & o) const {
+template <class T, class Nodes>
+bool DLinkedList<T, Nodes>::operator==(const DLinkedList<T, Nodes> & o) const {
 	bool same=true;
 	if (size() != o.size()) {
 		same = false;
 	}
 
-	for(int i=0; i<size() && same; i++) {
-		if (get(i) != o.get(i)) {
+	for(DListIterator<T> itr = begin(), oitr = o.begin(); itr != end() && same; itr++, oitr++) {
+		if ((*itr) != (*oitr)) {
 			same = false;
 		}
 	}
@@ -138,12 +169,12 @@ bool DLinkedList<T>::operator==(const DLinkedList<T> & o) const {
 
 // PreCondition: c is not null  
 // PostCondition: perform a deep copy of c
-template <class T>
-void DLinkedList<T>::deepCopy(const DLinkedList<T> & c) {
+template <class T, class Nodes>
+void DLinkedList<T, Nodes>::deepCopy(const DLinkedList<T, Nodes> & c) {
     DNode<T>* p = header;	// previous DNode pointer
     DNode<T>* n;				// new DNode pointer
     for(DListIterator<T> itr = c.begin(); itr != c.end(); ++itr) {
-        n = new DNode<T>(*itr, p, p->next); // create new DNode
+        n = nodes.create(*itr, p, p->next); // create new DNode
         n->prev->next = n;		// set last next to refer to n
         n->next->prev = n;		// set last prev to n
 		p = n;					// move p to new DNode
@@ -153,56 +184,244 @@ void DLinkedList<T>::deepCopy(const DLinkedList<T> & c) {
 
 // PreCondition:  none
 // PostCondition: return size of DLinkedList
-template <class T>
-int DLinkedList<T>::size() const{
+template <class T, class Nodes>
+int DLinkedList<T, Nodes>::size() const{
 	return count;
 }
 
 // PreCondition:  none
 // PostCondition: inserts element value at specified postion in DLinkedList
-template <class T>
-void DLinkedList<T>::add(int pos, const T & value) {
+template <class T, class Nodes>
+void DLinkedList<T, Nodes>::add(int pos, const T & value) {
 	if (pos < 0 || pos > size()) {
 		throw std::out_of_range("DLinkedList invalid position: " + std::to_string(pos));
 	}
 	
-	addBefore(value, (pos==count ? header : DNodeAt(pos)));
+	cursor = addBefore(value, (pos==count ? header : DNodeAt(pos)));
+	cursorPos = pos;
 }
 
 // PostCondition: inserts element value at end of DLinkedList
-template<class T>
-void DLinkedList<T>::add(const T & value) {
+template <class T, class Nodes>
+void DLinkedList<T, Nodes>::add(const T & value) {
 	add(size(),value);
 }
 
 
-// Post-Condition: Insert element before specified DNode  
-template <class T>
-void DLinkedList<T>::addBefore(const T & e, DNode<T> *p) {
-	DNode<T> *n = new DNode<T>(e, p->prev, p);
+// Post-Condition: Insert element before specified DNode, returns the new DNode
+template <class T, class Nodes>
+DNode<T>* DLinkedList<T, Nodes>::addBefore(const T & e, DNode<T> *p) {
+	DNode<T> *n = nodes.create(e, p->prev, p);
 	n->prev->next = n;
 	n->next->prev = n;
 	count++;
+	return n;
+}
+
+// PreCondition: pos refers to a DNode of this list or end()
+// PostCondition: value inserted before pos, returns iterator to it
+template <class T, class Nodes>
+DListIterator<T> DLinkedList<T, Nodes>::insertBefore(DListIterator<T> pos, const T & value) {
+	resetCursor();
+	return DListIterator<T>(addBefore(value, pos.current));
+}
+
+// PreCondition: pos refers to a DNode of this list
+// PostCondition: value inserted after pos, returns iterator to it
+template <class T, class Nodes>
+DListIterator<T> DLinkedList<T, Nodes>::insertAfter(DListIterator<T> pos, const T & value) {
+	if (pos.current == header) {
+		throw std::out_of_range("DLinkedList invalid iterator: end()");
+	}
+	resetCursor();
+	return DListIterator<T>(addBefore(value, pos.current->next));
+}
+
+// PreCondition: pos refers to a DNode of this list
+// PostCondition: DNode at pos removed, returns iterator to the DNode that followed it
+template <class T, class Nodes>
+DListIterator<T> DLinkedList<T, Nodes>::erase(DListIterator<T> pos) {
+	DNode<T> *d = pos.current;
+	if (d == header) {
+		throw std::out_of_range("DLinkedList invalid iterator: end()");
+	}
+	DNode<T> *next = d->next;
+	d->prev->next = d->next;		// disconnect DNode
+	d->next->prev = d->prev;
+	nodes.destroy(d);
+	count--;
+	resetCursor();
+	return DListIterator<T>(next);
+}
+
+// PreCondition: pos refers to a DNode of this list or end(), [first, last) is a range
+//               of other not containing pos
+// PostCondition: DNodes first up to but excluding last moved from other to before pos.
+//                O(1) within a list, O(k) between lists as the k DNodes moved are counted
+template <class T, class Nodes>
+void DLinkedList<T, Nodes>::splice(DListIterator<T> pos, DLinkedList<T, Nodes> & other, DListIterator<T> first, DListIterator<T> last) {
+	DNode<T> *f = first.current;
+	DNode<T> *l = last.current;
+	if (f == l) {
+		return;
+	}
+	DNode<T> *e = l->prev;			// last DNode moved
+	if (&other != this) {
+		int k = 1;
+		for (DNode<T> *n = f; n != e; n = n->next) {
+			k++;
+		}
+		other.count -= k;
+		count += k;
+		nodes.merge(other.nodes);	// DNodes of other are now released by this list
+	}
+
+	f->prev->next = l;				// unlink from other
+	l->prev = f->prev;
+
+	DNode<T> *p = pos.current;		// link before pos
+	f->prev = p->prev;
+	e->next = p;
+	p->prev->next = f;
+	p->prev = e;
+	resetCursor();
+	other.resetCursor();
+}
+
+// PreCondition: other is not this list
+// PostCondition: all DNodes of other moved to before pos in O(1), other is empty
+template <class T, class Nodes>
+void DLinkedList<T, Nodes>::splice(DListIterator<T> pos, DLinkedList<T, Nodes> & other) {
+	if (&other == this || other.isEmpty()) {
+		return;
+	}
+	DNode<T> *f = other.header->next;
+	DNode<T> *e = other.header->prev;
+	DNode<T> *p = pos.current;
+	f->prev = p->prev;
+	e->next = p;
+	p->prev->next = f;
+	p->prev = e;
+	count += other.count;
+	nodes.merge(other.nodes);
+	resetCursor();
+
+	other.header->next = other.header;
+	other.header->prev = other.header;
+	other.count = 0;
+	other.resetCursor();
+}
+
+// PostCondition: list sorted into the order given by cmp in O(n log n) - bottom up merge
+//                sort on the next links alone, keeping runs of 1, 2, 4 ... DNodes in bins
+//                as a binary counter, then the prev links are restored in one pass.
+//                Stable, equal elements keep their order
+template <class T, class Nodes>
+template <class Compare>
+void DLinkedList<T, Nodes>::sort(Compare cmp) {
+	if (count < 2) {
+		return;
+	}
+	DNode<T> *bins[32] = {};		// bins[i] empty or a sorted run of 2^i DNodes
+	header->prev->next = nullptr;
+	DNode<T> *n = header->next;
+	while (n != nullptr) {
+		DNode<T> *run = n;
+		n = n->next;
+		run->next = nullptr;
+		int i = 0;
+		for (; bins[i] != nullptr; i++) {	// earlier DNodes are in bins[i], so it goes first
+			run = mergeRuns(bins[i], run, cmp);
+			bins[i] = nullptr;
+		}
+		bins[i] = run;
+	}
+	DNode<T> *sorted = nullptr;
+	for (int i = 0; i < 32; i++) {			// higher bins hold the earlier DNodes
+		if (bins[i] != nullptr) {
+			sorted = mergeRuns(bins[i], sorted, cmp);
+		}
+	}
+	relink(sorted);
+}
+
+// PreCondition: this list and other are both sorted by cmp
+// PostCondition: DNodes of other merged into this list in one pass, keeping it sorted,
+//                other is empty. On equal elements those of this list come first
+template <class T, class Nodes>
+template <class Compare>
+void DLinkedList<T, Nodes>::merge(DLinkedList<T, Nodes> & other, Compare cmp) {
+	if (&other == this || other.isEmpty()) {
+		return;
+	}
+	header->prev->next = nullptr;
+	other.header->prev->next = nullptr;
+	relink(mergeRuns(header->next, other.header->next, cmp));
+	count += other.count;
+	nodes.merge(other.nodes);
+
+	other.header->next = other.header;
+	other.header->prev = other.header;
+	other.count = 0;
+	other.resetCursor();
+}
+
+// PreCondition: a and b are null terminated runs, on next links, sorted by cmp
+// PostCondition: returns the two runs merged into one, DNodes of a first on equal elements
+template <class T, class Nodes>
+template <class Compare>
+DNode<T>* DLinkedList<T, Nodes>::mergeRuns(DNode<T> *a, DNode<T> *b, Compare & cmp) {
+	DNode<T> *merged;
+	DNode<T> **link = &merged;		// where the next DNode taken is linked
+	while (a != nullptr && b != nullptr) {
+		if (cmp(b->data, a->data)) {
+			*link = b;
+			b = b->next;
+		} else {
+			*link = a;
+			a = a->next;
+		}
+		link = &(*link)->next;
+	}
+	*link = (a != nullptr) ? a : b;
+	return merged;
+}
+
+// PreCondition: first is a null terminated run on next links
+// PostCondition: run becomes the list contents, prev links and the header ring restored
+template <class T, class Nodes>
+void DLinkedList<T, Nodes>::relink(DNode<T> *first) {
+	DNode<T> *p = header;
+	for (DNode<T> *n = first; n != nullptr; n = n->next) {
+		p->next = n;
+		n->prev = p;
+		p = n;
+	}
+	p->next = header;
+	header->prev = p;
+	resetCursor();
 }
 
 // PreCondition:  none
 // PostCondition: deletes DNode at specified postion in DLinkedList
-template <class T>
-void DLinkedList<T>::remove(int pos) {
+template <class T, class Nodes>
+void DLinkedList<T, Nodes>::remove(int pos) {
 	if (pos < 0 || pos >= size()) {
 		throw std::out_of_range("DLinkedList invalid position: " + std::to_string(pos));
 	}
 	DNode<T> *d = DNodeAt(pos);		// locate DNode to delete
 	d->prev->next = d->next;		// disconnect DNode
 	d->next->prev = d->prev;
-	delete d;
+	cursor = d->prev;				// keep cursor on the preceding DNode
+	cursorPos = pos - 1;
+	nodes.destroy(d);
   	count--;
 }
 
 
 // PostCondition: returns index of DLinkedList item if found or -1 if not found
-template<class T>
-int DLinkedList<T>::find(const T & value) const {
+template <class T, class Nodes>
+int DLinkedList<T, Nodes>::find(const T & value) const {
 	int i=0;
 	for (DListIterator<T> itr = begin(); itr != end(); itr++, i++) {
 		if ((*itr) == value) {
@@ -214,8 +433,8 @@ int DLinkedList<T>::find(const T & value) const {
 
 // PreCondition:  none
 // PostCondition: deletes DNode at specified postion in linked DLinkedList
-template <class T>
-T DLinkedList<T>::get(int pos) const {
+template <class T, class Nodes>
+T DLinkedList<T, Nodes>::get(int pos) const {
 	if (pos < 0 || pos >= size()) {
 		throw std::out_of_range("DLinkedList invalid position: " + std::to_string(pos));
 	}
@@ -224,8 +443,8 @@ T DLinkedList<T>::get(int pos) const {
 
 // PreCondition:  none
 // PostCondition: updates value part of DNode at specified postion in linked DLinkedList
-template <class T>
-void DLinkedList<T>::set(int pos, const T & value) {
+template <class T, class Nodes>
+void DLinkedList<T, Nodes>::set(int pos, const T & value) {
 	if (pos < 0 || pos >= size()) {
 		throw std::out_of_range("DLinkedList invalid position: " + std::to_string(pos));
 	}
@@ -236,8 +455,8 @@ void DLinkedList<T>::set(int pos, const T & value) {
 
 // PreCondition:  none
 // PostCondition: prints DLinkedList to output stream using an iterator
-template <class T>
-void DLinkedList<T>::print(std::ostream & os) const {
+template <class T, class Nodes>
+void DLinkedList<T, Nodes>::print(std::ostream & os) const {
 	os << "[ ";
  	for(DListIterator<T> itr = begin(); itr != end(); ++itr) {
 		os << *itr << " ";
@@ -246,46 +465,64 @@ void DLinkedList<T>::print(std::ostream & os) const {
 }
 
 // PreCondition:  pos is valid and DLinkedList is not empty
-// PostCondition: returns reference to DNode at specified position
-template <class T>
-DNode<T>* DLinkedList<T>::DNodeAt(int pos) const {	
+// PostCondition: returns reference to DNode at specified position, walking from the
+//                nearest of the front, the back and the cursor, and leaves the cursor there
+template <class T, class Nodes>
+DNode<T>* DLinkedList<T, Nodes>::DNodeAt(int pos) const {	
 	DNode<T> *n = header;
-	for (int i = 0; i <= pos; i++) {
+	int i = -1;
+	if (pos >= count / 2) {				// header is also position count, walk back
+		i = count;
+	}
+	if (std::abs(pos - cursorPos) < std::abs(pos - i)) {
+		n = cursor;
+		i = cursorPos;
+	}
+	for (; i < pos; i++) {
 		n = n->next;
 	}
+	for (; i > pos; i--) {
+		n = n->prev;
+	}
+	cursor = n;
+	cursorPos = pos;
     return n;
 }
 
-// Post-Condition: DLinkedList is emptied
-template <class T>
-void DLinkedList<T>::clear() {
+// Post-Condition: DLinkedList is emptied, all DNodes are released together
+template <class T, class Nodes>
+void DLinkedList<T, Nodes>::clear() {
 	DNode<T> *tmp, *d;
 	
-	tmp = header->next;
-	// while we have not returned to the header
-	while (tmp != header) { 	
-		d = tmp; 			// set d to refer to DNode to be deleted
-		tmp = tmp->next; 	// move tmp on to next DNode
-		delete d;			// delete DNode refered to by d
+	if (!nodes.discardIsTrivial()) {
+		tmp = header->next;
+		// while we have not returned to the header
+		while (tmp != header) { 	
+			d = tmp; 			// set d to refer to DNode to be released
+			tmp = tmp->next; 	// move tmp on to next DNode
+			nodes.discard(d);	// destruct DNode refered to by d
+		}
 	}
+	nodes.reset();
 	header->next = header;  // reset header
 	header->prev = header;
 	count = 0;				// reset count to zero	
+	resetCursor();
 
 	//  for(int i=size()-1; i>=0; i--)
 	//  	remove(i);
 	//  return;
 }
 
-template <class T>
-bool DLinkedList<T>::isEmpty() const {
+template <class T, class Nodes>
+bool DLinkedList<T, Nodes>::isEmpty() const {
 	return (count == 0);
 }
 
 // PreCondition: None
 // PostCondition: overload << operator to output DLinkedList on ostream
-template <class T>
-std::ostream& operator <<(std::ostream& output, const DLinkedList<T>& l) {
+template <class T, class Nodes>
+std::ostream& operator <<(std::ostream& output, const DLinkedList<T, Nodes>& l) {
     l.print(output);
     return output;  // for multiple << operators.
 }
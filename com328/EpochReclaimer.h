@@ -0,0 +1,202 @@
+/**
+ * EpochReclaimer.h
+ *
+ * Epoch based memory reclamation for the lock free containers. A node that has
+ * been unlinked may still be read by threads that reached it beforehand, so it is
+ * retired rather than deleted, and freed once every such thread has moved on.
+ *
+ * Threads access a container inside an EpochReclaimer::Guard, which announces
+ * the global epoch the thread entered in. The epoch only advances when every
+ * thread inside a guard has announced the current one, so a node retired in
+ * epoch e is unreachable to all readers once the epoch reaches e + 2.
+ *
+ *   {
+ *       EpochReclaimer::Guard g;	// before reading shared nodes
+ *       ... unlink n ...
+ *       EpochReclaimer::retire(n);	// deleted when no reader can hold it
+ *   }
+ *
+ * One reclaimer is shared by every container in the process. Each thread keeps
+ * its retired nodes in a record of its own, reused by a later thread when it
+ * exits. A thread that stays inside a guard holds back reclamation for all.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.0
+ */
+
+#ifndef EPOCHRECLAIMER_H_
+#define EPOCHRECLAIMER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+class EpochReclaimer {
+public:
+	static const int RECLAIM_EVERY = 64;	// retires between attempts to free nodes
+
+	// Scope in which a thread may read nodes of lock free containers, may be nested
+	class Guard {
+	public:
+		Guard();
+		~Guard();
+		Guard(const Guard &) = delete;
+		Guard & operator=(const Guard &) = delete;
+	};
+
+	template <class N>
+	static void retire(N *n)		{ retire(n, [](void *p) { delete static_cast<N*>(p); }); }
+	static void retire(void *p, void (*free)(void *));
+
+private:
+	struct Retired {
+		void *p;
+		void (*free)(void *);
+		std::uint64_t epoch;	// global epoch when retired
+	};
+
+	struct Record {
+		std::atomic<std::uint64_t> epoch;	// (epoch << 1) | 1 inside a guard, 0 outside
+		std::atomic<bool> inUse;
+		Record *next;						// fixed once published
+		int depth;							// guard nesting, owner only
+		std::vector<Retired> retired;		// owner only, oldest first
+		std::uint64_t reclaimed;			// global epoch at the last reclaim, owner only
+		Record() : epoch(0), inUse(true), next(nullptr), depth(0), reclaimed(0) {}
+	};
+
+	// record of the calling thread, released to the next thread when it exits
+	struct Local {
+		Record *record;
+		Local();
+		~Local();
+	};
+
+	EpochReclaimer() : global(0), records(nullptr) {}
+	~EpochReclaimer();
+	EpochReclaimer(const EpochReclaimer &) = delete;
+	EpochReclaimer & operator=(const EpochReclaimer &) = delete;
+
+	static EpochReclaimer & instance()	{ static EpochReclaimer r; return r; }
+	static Record * local()				{ instance(); static thread_local Local l; return l.record; }
+
+	Record * acquire();
+	bool tryAdvance();
+	void reclaim(Record *r);
+
+	std::atomic<std::uint64_t> global;
+	std::atomic<Record*> records;		// every record, pushed at the front, never removed
+};
+
+// ========================= IMPLEMENTATION EpochReclaimer.cpp ===================================
+
+// PostCondition: calling thread announces the global epoch, confirmed unchanged after
+//                the announcement, so the epoch cannot advance twice while it is inside
+inline EpochReclaimer::Guard::Guard() {
+	EpochReclaimer & er = instance();
+	Record *r = local();
+	if (r->depth++ == 0) {
+		std::uint64_t e = er.global.load();
+		for (;;) {
+			r->epoch.store((e << 1) | 1);
+			std::uint64_t now = er.global.load();
+			if (now == e) {
+				break;
+			}
+			e = now;
+		}
+	}
+}
+
+// PostCondition: calling thread no longer holds back the epoch when leaving its outer guard
+inline EpochReclaimer::Guard::~Guard() {
+	Record *r = local();
+	if (--r->depth == 0) {
+		r->epoch.store(0, std::memory_order_release);
+	}
+}
+
+// PreCondition: p has been unlinked, so no thread entering a guard from now on can reach it
+// PostCondition: p is freed by free(p) once no reader can hold it
+inline void EpochReclaimer::retire(void *p, void (*free)(void *)) {
+	EpochReclaimer & er = instance();
+	Record *r = local();
+	r->retired.push_back(Retired{ p, free, er.global.load() });
+	if (r->retired.size() % RECLAIM_EVERY == 0 && er.tryAdvance()) {
+		er.reclaim(r);
+	}
+}
+
+// PostCondition: the reclaimer is only destroyed at exit, after every thread, so all
+//                remaining retired nodes are freed
+inline EpochReclaimer::~EpochReclaimer() {
+	Record *r = records.load();
+	while (r != nullptr) {
+		for (const Retired & d : r->retired) {
+			d.free(d.p);
+		}
+		Record *next = r->next;
+		delete r;
+		r = next;
+	}
+}
+
+// PostCondition: returns a record not in use by another thread, adding one if none is free
+inline EpochReclaimer::Record * EpochReclaimer::acquire() {
+	for (Record *r = records.load(); r != nullptr; r = r->next) {
+		bool free = false;
+		if (!r->inUse.load() && r->inUse.compare_exchange_strong(free, true)) {
+			return r;
+		}
+	}
+	Record *r = new Record;
+	Record *head = records.load();
+	do {
+		r->next = head;
+	} while (!records.compare_exchange_weak(head, r));
+	return r;
+}
+
+// PostCondition: global epoch advanced if every thread inside a guard entered in it,
+//                returns true if the epoch has moved on from the one read
+inline bool EpochReclaimer::tryAdvance() {
+	std::uint64_t e = global.load();
+	for (Record *r = records.load(); r != nullptr; r = r->next) {
+		std::uint64_t re = r->epoch.load();
+		if ((re & 1) != 0 && (re >> 1) != e) {
+			return false;
+		}
+	}
+	global.compare_exchange_strong(e, e + 1);
+	return true;
+}
+
+// PreCondition: r is the record of the calling thread
+// PostCondition: nodes retired at least two epochs ago freed and removed from r. They
+//                are the oldest, so only that prefix is visited, and only once per epoch
+inline void EpochReclaimer::reclaim(Record *r) {
+	std::uint64_t e = global.load();
+	if (e == r->reclaimed) {
+		return;
+	}
+	r->reclaimed = e;
+	std::size_t freed = 0;
+	while (freed < r->retired.size() && e - r->retired[freed].epoch >= 2) {
+		r->retired[freed].free(r->retired[freed].p);
+		freed++;
+	}
+	r->retired.erase(r->retired.begin(), r->retired.begin() + freed);
+}
+
+inline EpochReclaimer::Local::Local() : record(instance().acquire()) {}
+
+// PostCondition: what can be freed is, the rest is left for the next thread to use record
+inline EpochReclaimer::Local::~Local() {
+	EpochReclaimer & er = instance();
+	er.tryAdvance();
+	er.reclaim(record);
+	record->inUse.store(false, std::memory_order_release);
+}
+
+#endif
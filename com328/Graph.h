@@ -37,6 +37,9 @@ public:
 	bool isDirected() const;
 	bool vertexExists(std::string l) const;
 
+	void writeTo(SnapshotWriter & w) const;
+	void readFrom(SnapshotReader & r);
+
 private:
 	struct Vertex {
 		std::string label;
@@ -63,10 +66,8 @@ private:
 // PostCondition: a new graph of specified size is created
 Graph::Graph(int size, bool dir) : vertices(size), matrix(size), count{ 0 }, directed{ dir } {
 	for (int i = 0; i < matrix.length(); i++) {
-		matrix[i] = Array<int>(size);
-		for (int y = 0; y < matrix[i].length(); y++) {
-			matrix[i][y] = 0;
-		}
+		matrix.unchecked_at(i) = Array<int>(size);
+		matrix.unchecked_at(i).initialise(0);
 	}
 }
 
@@ -229,6 +230,51 @@ void Graph::print(std::ostream & out) const {
 	std::cout << std::endl;
 }
 
+// PostCondition: size, direction, vertex labels and adjacency matrix written to
+//                snapshot, each matrix row with a single bulk write
+void Graph::writeTo(SnapshotWriter & w) const {
+	w.writeTag("GRPH");
+	w.writeCount(vertices.length());
+	w.writeCount(count);
+	writeValue(w, directed);
+	for (int i = 0; i < count; i++) {
+		writeValue(w, vertices.unchecked_at(i).label);
+	}
+	for (int i = 0; i < matrix.length(); i++) {
+		matrix.unchecked_at(i).writeTo(w);
+	}
+}
+
+// PreCondition: next container in snapshot is a Graph
+// PostCondition: graph replaced by the graph read from snapshot, no vertex is visited
+void Graph::readFrom(SnapshotReader & r) {
+	r.readTag("GRPH");
+	int size = r.readCount();
+	int used = r.readCount();
+	bool dir;
+	readValue(r, dir);
+	if (used > size) {
+		throw std::runtime_error("Snapshot: corrupt Graph vertex count");
+	}
+	// every matrix row holds size ints, so the rest of the payload bounds size
+	if ((std::uint64_t)size * size * sizeof(int) > r.remaining()) {
+		throw std::runtime_error("Snapshot: corrupt Graph size");
+	}
+
+	Graph g(size, dir);
+	for (int i = 0; i < used; i++) {
+		std::string label;
+		readValue(r, label);
+		g.addVertex(label);
+	}
+	for (int i = 0; i < size; i++) {
+		g.matrix.unchecked_at(i).readFrom(r);
+		if (g.matrix.unchecked_at(i).length() != size) {
+			throw std::runtime_error("Snapshot: corrupt Graph matrix");
+		}
+	}
+	*this = std::move(g);
+}
 
 // PostCondition: compute transitive closure of Graph
 void Graph::transClose(int weight = 2) {
@@ -236,10 +282,10 @@ void Graph::transClose(int weight = 2) {
 
 	for (i = 0; i < count; i++) {
 		for (j = 0; j < count; j++) {
-			if (matrix[j][i] > 0) {
+			if (matrix.unchecked_at(j).unchecked_at(i) > 0) {
 				for (k = 0; k < count; k++) {
-					if (matrix[i][k] > 0) {
-						matrix[j][k] = weight;
+					if (matrix.unchecked_at(i).unchecked_at(k) > 0) {
+						matrix.unchecked_at(j).unchecked_at(k) = weight;
 					}
 				} // for
 			} // if
@@ -287,7 +333,7 @@ void Graph::spanningTree(std::string label) {
 // PostCondition: visited flag for each Vertex is reset
 void Graph::resetVisitedVertices() {
 	for (int i = 0; i < count; i++) {
-		vertices[i].visited = false;
+		vertices.unchecked_at(i).visited = false;
 	}
 }
 
@@ -295,8 +341,9 @@ void Graph::resetVisitedVertices() {
 // PostCondtion: return the index of an unvisited vertex adjacent to v
 //               or -1 if no unvisited vertex available
 int Graph::adjacentUnvisitedVertex(int v) {
+	const Array<int> & row = matrix.unchecked_at(v);
 	for (int i = 0; i < count; i++) {
-		if (matrix[v][i] > 0 && (!vertices[i].visited)) {
+		if (row.unchecked_at(i) > 0 && (!vertices.unchecked_at(i).visited)) {
 			return i;
 		}
 	}
@@ -308,7 +355,7 @@ int Graph::adjacentUnvisitedVertex(int v) {
 // PostConditon: index of vertex with specified label is returned
 int Graph::findVertex(std::string label) const {
 	for (int i = 0; i < vertices.length(); i++) {
-		if (vertices[i].label == label) {
+		if (vertices.unchecked_at(i).label == label) {
 			return i;
 		}
 	}
@@ -317,16 +364,17 @@ int Graph::findVertex(std::string label) const {
 
 // PostCondition: determine if there is a path between src and dst in specified steps
 bool Graph::stepsTo(int src, int dst, int steps) const {
+	const Array<int> & row = matrix.unchecked_at(src);
 	bool result = false;
 	if (steps == 1) {
-		result = matrix[src][dst] > 0;
+		result = row.unchecked_at(dst) > 0;
 	}
-	else if (matrix[src][dst] > 0) {
+	else if (row.unchecked_at(dst) > 0) {
 		result = true;
 	}
 	else {
 		for (int i = 0; i < count - 1; i++) {
-			if ((matrix[src][i] > 0) && stepsTo(i, dst, steps - 1)) {
+			if ((row.unchecked_at(i) > 0) && stepsTo(i, dst, steps - 1)) {
 				result = true;
 			}
 		}
@@ -28,6 +28,9 @@ public:
 	void print(std::ostream & out) const;
 	void rehash(int size);
 
+	void writeTo(SnapshotWriter & w) const;
+	void readFrom(SnapshotReader & r);
+
 private:
 	struct HashEntry {
 	   std::string key;
@@ -130,6 +133,44 @@ bool HashTable<T>::find(std::string key, T & val) const {
 }
 
 
+// PostCondition: table size and each chain of entries written to snapshot
+template <class T>
+void HashTable<T>::writeTo(SnapshotWriter & w) const {
+	w.writeTag("HTCH");
+	w.writeCount(table.length());
+	for (int i = 0; i < table.length(); i++) {
+		const LinkedList<HashEntry> & list = table[i];
+		w.writeCount(list.size());
+		for (ListIterator<HashEntry> itr = list.begin(); itr != list.end(); itr++) {
+			writeValue(w, (*itr).key);
+			writeValue(w, (*itr).element);
+		}
+	}
+}
+
+// PreCondition: next container in snapshot is a chaining HashTable
+// PostCondition: table replaced by the chains read from snapshot, in their saved order
+template <class T>
+void HashTable<T>::readFrom(SnapshotReader & r) {
+	r.readTag("HTCH");
+	int size = r.readCount();
+	if (size < 1) {
+		throw std::runtime_error("Snapshot: corrupt HashTable size");
+	}
+	table = Array< LinkedList<HashEntry> >(size);
+	currentsize = 0;
+	for (int i = 0; i < table.length(); i++) {
+		int entries = r.readCount();
+		for (int e = 0; e < entries; e++) {
+			HashEntry entry;
+			readValue(r, entry.key);
+			readValue(r, entry.element);
+			table[i].add(entry);
+			currentsize++;
+		}
+	}
+}
+
 // PostCondition: table HashEntries are printed to output stream
 template <class T>
 void HashTable<T>::print(std::ostream & out) const {
@@ -27,6 +27,9 @@ public:
 	void print(std::ostream & out) const ;
 	void rehash(int size);
 
+	void writeTo(SnapshotWriter & w) const;
+	void readFrom(SnapshotReader & r);
+
 private:
 	enum EntryType { ACTIVE, EMPTY, DELETED };
 
@@ -203,6 +206,43 @@ int HashTable<T>::findPosSecondary(const std::string & key) const {
 	return pos;
 }
 
+// PostCondition: table size and active entries written to snapshot
+template <class T>
+void HashTable<T>::writeTo(SnapshotWriter & w) const {
+	w.writeTag("HTOP");
+	w.writeCount(table.length());
+	w.writeCount(currentsize);
+	for (int i = 0; i < table.length(); i++) {
+		if (isActive(i)) {
+			writeValue(w, table[i].key);
+			writeValue(w, table[i].element);
+		}
+	}
+}
+
+// PreCondition: next container in snapshot is an open addressing HashTable
+// PostCondition: table replaced by one of the saved size holding the entries read
+//                from snapshot, deleted entries are not restored
+template <class T>
+void HashTable<T>::readFrom(SnapshotReader & r) {
+	r.readTag("HTOP");
+	int size = r.readCount();
+	int entries = r.readCount();
+	if (size < 1 || entries > size) {
+		throw std::runtime_error("Snapshot: corrupt HashTable size");
+	}
+
+	table = Array<HashEntry>(size);
+	currentsize = 0;
+	for (int i = 0; i < entries; i++) {
+		std::string key;
+		T value;
+		readValue(r, key);
+		readValue(r, value);
+		add(key, value);
+	}
+}
+
 // PostCondition: table HashEntries are printed to output stream
 template <class T>
 void HashTable<T>::print(std::ostream & out) const {
@@ -18,21 +18,33 @@
 #include "FluentSet.h"
 
 #include "Array.h"
+#include "SmallArray.h"
+#include "CowArray.h"
+#include "AlignedArray.h"
+#include "MappedArray.h"
 
 #include "ArrayCollection.h"
 #include "FluentCollection.h"
 
 #include "ArrayStack.h"
 #include "FluentStack.h"
+#include "ConcurrentStack.h"
 
 #include "ArrayQueue.h"
 #include "FluentQueue.h"
+#include "SpscQueue.h"
+#include "MpmcQueue.h"
+#include "BlockingQueue.h"
 
 #include "DoubleLinkedList.h"
 #include "LinkedList.h"
+#include "UnrolledList.h"
+#include "SkipList.h"
+#include "ConcurrentLinkedList.h"
 #include "ArrayList.h"
 #include "FluentList.h"
 #include "OrderedList.h"
+#include "PersistentVector.h"
 
 #include "Database.h"
 #include "FluentDatabase.h"
@@ -50,12 +62,21 @@
 #include "Graph.h"
 #include "Search.h"
 #include "Sort.h"
+#include "Snapshot.h"
 
 #include <iostream>
 #include <string>
-
-//#include <algorithm>
-//#include <functional>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
 //#include <array>
 //#include <iterator>
 //#include <set> 
@@ -153,6 +174,329 @@ TEST_CASE("Array Axioms", "[Array]")
 		REQUIRE_THROWS(a[1] = 1);
 	}
 
+	SECTION("Test Reserve Doesn't Change Length")
+	{
+		Array<int> a(3); a[0] = 1; a[1] = 2; a[2] = 3;
+		a.reserve(100);
+
+		REQUIRE(a.length() == 3);
+		REQUIRE(a.capacity() == 100);
+		REQUIRE(a[2] == 3);
+		REQUIRE_THROWS(a[3] = 4);
+	}
+
+	SECTION("Test Shrink Then Shrink To Fit")
+	{
+		Array<int> a(5); a[0] = 1; a[1] = 2;
+		a.resize(2);
+		REQUIRE(a.capacity() == 5);
+
+		a.shrink_to_fit();
+		REQUIRE(a.capacity() == 2);
+		REQUIRE(a[0] == 1);
+		REQUIRE(a[1] == 2);
+	}
+
+	SECTION("Test Resize Moves String Contents")
+	{
+		Array<std::string> a(2); a[0] = "apple"; a[1] = "orange";
+		a.resize(1000);
+
+		REQUIRE(a.length() == 1000);
+		REQUIRE(a[0] == "apple");
+		REQUIRE(a[1] == "orange");
+		REQUIRE(a[999] == "");
+	}
+
+	SECTION("Test Copy And Move")
+	{
+		Array<std::string> a(2); a[0] = "apple"; a[1] = "orange";
+		Array<std::string> c(a);
+		Array<std::string> m(std::move(a));
+
+		REQUIRE(a.length() == 0);
+		REQUIRE(m.length() == 2);
+		REQUIRE(m[1] == c[1]);
+
+		c = m;
+		REQUIRE(c[0] == "apple");
+	}
+
+	SECTION("Test Bounds Policies")
+	{
+		Array<int, AssertBounds> a(3);
+		Array<int, UncheckedBounds> u(3);
+		a[0] = 3; a[1] = 1; a[2] = 2;
+		u[0] = 3; u[1] = 1; u[2] = 2;
+
+		quickSort(a);
+		insertionSort(u);
+
+		REQUIRE(a[0] == 1);
+		REQUIRE(u.unchecked_at(2) == 3);
+		REQUIRE(binarySearch(u, 2) == 1);
+	}
+}
+
+/**
+ *  SmallArray Test Axioms
+ */
+TEST_CASE("SmallArray Axioms", "[SmallArray]")
+{
+	SmallArray<std::string, 4> a(2);
+	a[0] = "apple"; a[1] = "orange";
+
+	SECTION("Test Inline Until Full")
+	{
+		a.resize(4);
+		REQUIRE(a.isInline() == true);
+		REQUIRE(a.capacity() == 4);
+	}
+
+	SECTION("Test Spill To Heap Keeps Contents")
+	{
+		a.resize(10);
+		REQUIRE(a.isInline() == false);
+		REQUIRE(a.length() == 10);
+		REQUIRE(a[1] == "orange");
+
+		a.resize(2);
+		a.shrink_to_fit();
+		REQUIRE(a.isInline() == true);
+		REQUIRE(a[0] == "apple");
+	}
+
+	SECTION("Test Copy And Move")
+	{
+		SmallArray<std::string, 4> c(a);
+		SmallArray<std::string, 4> m(std::move(a));
+		Array<std::string> h(std::move(m));			// may allocate, so not noexcept
+
+		REQUIRE(c.isInline() == true);
+		REQUIRE(c[1] == "orange");
+		REQUIRE(m.length() == 0);
+		REQUIRE(h[0] == "apple");
+		REQUIRE(std::is_nothrow_move_constructible<SmallArray<std::string, 4> >::value);
+		REQUIRE_FALSE(std::is_nothrow_move_constructible<Array<std::string> >::value);
+	}
+
+	SECTION("Test Sorts As An Array")
+	{
+		SmallArray<int, 8> s(3);
+		s[0] = 3; s[1] = 1; s[2] = 2;
+		selectionSort(s);
+
+		REQUIRE(isOrdered<int>(s) == true);
+	}
+
+	SECTION("Test As Backing Store")
+	{
+		typedef ArrayList<int, CheckedBounds, SmallArray<int, 16> > SmallList;
+		SmallList l;
+		Stack<int, CheckedBounds, SmallArray<int, 16> > st;
+		Collection<int, CheckedBounds, SmallArray<int, 16> > c;
+		auto isInline = [](const SmallList & s) {
+			const char *p = reinterpret_cast<const char*>(s.data());
+			return p >= reinterpret_cast<const char*>(&s) && p < reinterpret_cast<const char*>(&s + 1);
+		};
+		for (int i = 0; i < 16; i++) {
+			l.add(i);
+		}
+		REQUIRE(isInline(l) == true);
+		for (int i = 16; i < 20; i++) {
+			l.add(i);
+		}
+		REQUIRE(isInline(l) == false);
+		for (int i = 0; i < 20; i++) {
+			c.add(i);
+		}
+		st.push(1); st.push(2);
+
+		REQUIRE(l.size() == 20);
+		REQUIRE(l.get(19) == 19);
+		REQUIRE(c.count(19) == 1);
+		REQUIRE(st.top() == 2);
+	}
+}
+
+/**
+ *  AlignedArray Test Axioms
+ */
+TEST_CASE("AlignedArray Axioms", "[AlignedArray]")
+{
+	AlignedArray<int> a(37);
+	for (int i = 0; i < a.length(); i++) {
+		a[i] = i - 10;
+	}
+
+	SECTION("Test Aligned After Growth")
+	{
+		REQUIRE(a.isAligned() == true);
+		REQUIRE(a.capacity() % 16 == 0);
+
+		a.resize(1000);
+		REQUIRE(a.isAligned() == true);
+		REQUIRE(a[36] == 26);
+	}
+
+	SECTION("Test Reductions")
+	{
+		REQUIRE(a.sum() == 296);
+		REQUIRE(a.min() == -10);
+		REQUIRE(a.max() == 26);
+		REQUIRE(a.count_if([](int v) { return v < 0; }) == 10);
+		REQUIRE_THROWS_AS(AlignedArray<int>().min(), std::out_of_range);
+	}
+
+	SECTION("Test Initialise And Order")
+	{
+		REQUIRE(isOrdered(a) == true);
+		a[30] = 100;
+		REQUIRE(isOrdered(a) == false);
+
+		a.initialise(7);
+		REQUIRE(countOccurrence(a, 7) == 37);
+		REQUIRE(isOrdered(a) == true);
+	}
+
+	SECTION("Test Every Kernel Level Agrees With Scalar")
+	{
+		IntKernels scalar = simdKernels(SIMD_SCALAR);
+		for (int level = SIMD_SCALAR; level <= detectSimdLevel(); level++) {
+			IntKernels k = simdKernels(SimdLevel(level));
+			for (int n = 1; n < a.length(); n++) {
+				REQUIRE(k.sum(a.data(), n) == scalar.sum(a.data(), n));
+				REQUIRE(k.min(a.data() + 1, n) == scalar.min(a.data() + 1, n));
+				REQUIRE(k.max(a.data() + 1, n) == scalar.max(a.data() + 1, n));
+				REQUIRE(k.count(a.data(), n, 3) == scalar.count(a.data(), n, 3));
+				REQUIRE(k.isOrdered(a.data(), n) == true);
+			}
+			a[20] = -50;
+			REQUIRE(k.isOrdered(a.data(), a.length()) == false);
+			REQUIRE(k.min(a.data(), a.length()) == -50);
+			a[20] = 10;
+		}
+	}
+
+	SECTION("Test Move Takes Over Aligned Storage")
+	{
+		REQUIRE(std::is_nothrow_move_constructible<AlignedArray<std::string> >::value);
+		const int *p = a.data();
+		AlignedArray<int> m(std::move(a));
+		REQUIRE(m.data() == p);
+		REQUIRE(m.length() == 37);
+		REQUIRE(a.length() == 0);
+
+		AlignedArray<int> n(5);
+		n = std::move(m);
+		REQUIRE(n.data() == p);
+		REQUIRE(n[36] == 26);
+		REQUIRE(m.length() == 0);
+
+		a.resize(3);
+		REQUIRE(a.isAligned() == true);
+	}
+}
+
+TEST_CASE("MappedArray Axioms", "[MappedArray]")
+{
+	Array<int> values(100);
+	for (int i = 0; i < values.length(); i++) {
+		values[i] = (i * 37) % 100;		// each of 0..99 once, unordered
+	}
+	MappedArray<int>::save(values, "mapped.bin");
+
+	SECTION("Test Read Only Search")
+	{
+		MappedArray<const int> m("mapped.bin");
+		REQUIRE(std::is_same<decltype(m[0]), const int &>::value);
+		REQUIRE(m.length() == 100);
+		REQUIRE(m.isMapped() == true);
+		REQUIRE(m[1] == 37);
+		REQUIRE(isOrdered(m) == false);
+		REQUIRE(countOccurrence(m, 74) == 1);
+		REQUIRE(sequentialSearch(m, 74) == 2);
+	}
+
+	SECTION("Test Copy On Write Sort Leaves File Unchanged")
+	{
+		{
+			MappedArray<int> m("mapped.bin", MAP_COPY_ON_WRITE);
+			quickSort(m);
+			REQUIRE(isOrdered(m) == true);
+			REQUIRE(binarySearch(m, 42) == 42);
+		}
+		MappedArray<const int> again("mapped.bin");
+		REQUIRE(again[1] == 37);
+	}
+
+	SECTION("Test Growth Moves To Heap")
+	{
+		MappedArray<int> m("mapped.bin", MAP_COPY_ON_WRITE);
+		m.resize(150);
+		REQUIRE(m.isMapped() == false);
+		REQUIRE(m[99] == 63);
+	}
+
+	SECTION("Test Missing File Throws")
+	{
+		REQUIRE_THROWS_AS(MappedArray<int>("no-such-file.bin"), std::runtime_error);
+		REQUIRE_THROWS_AS(MappedArray<const int>("no-such-file.bin"), std::runtime_error);
+	}
+
+	SECTION("Test Writable Read Only Mapping Rejected")
+	{
+		REQUIRE_THROWS_AS(MappedArray<int>("mapped.bin", MAP_READ_ONLY), std::invalid_argument);
+	}
+
+	std::remove("mapped.bin");
+}
+
+TEST_CASE("CowArray Axioms", "[CowArray]")
+{
+	CowArray<std::string> a(3);
+	a[0] = "apple"; a[1] = "orange"; a[2] = "pear";
+
+	SECTION("Test Copies Share Until Written")
+	{
+		CowArray<std::string> b(a);
+		const CowArray<std::string> & cb = b;
+		REQUIRE(a.isShared() == true);
+		REQUIRE(cb[1] == "orange");
+		REQUIRE(a.isShared() == true);
+
+		b[1] = "lemon";
+		REQUIRE(a.isShared() == false);
+		REQUIRE(a[1] == "orange");
+		REQUIRE(b[1] == "lemon");
+	}
+
+	SECTION("Test CowArrayList Copy Is Independent")
+	{
+		CowArrayList<int> l;
+		l.add(1); l.add(2); l.add(3);
+		CowArrayList<int> snapshot(l);
+
+		l.set(0, 9);
+		l.add(4);
+		REQUIRE(snapshot.size() == 3);
+		REQUIRE(snapshot.get(0) == 1);
+		REQUIRE(l.get(0) == 9);
+		REQUIRE(snapshot != l);
+	}
+
+	SECTION("Test CowDatabase Snapshot")
+	{
+		CowDatabase<std::string> d;
+		d.add("apple"); d.add("orange");
+		CowDatabase<std::string> snapshot(d);
+
+		d.first();
+		d.set("lemon");
+		snapshot.first();
+		REQUIRE(snapshot.get() == "apple");
+		REQUIRE(d.get() == "lemon");
+	}
 }
 
 /**
@@ -224,6 +568,73 @@ TEST_CASE("Queue Axioms", "[Queue]")
 	{
 		REQUIRE(q.enqueue("apple").enqueue("orange").enqueue("pear").dequeue().peek() == std::string("orange"));
 	}
+
+	SECTION("Test Fixed Capacity Wraps Then Overflows")
+	{
+		Queue<int> f(3);
+		REQUIRE(f.capacity() == 3);
+		for (int i = 0; i < 10; i++) {		// wraps the ring buffer of 4 several times
+			f.enqueue(i);
+			f.enqueue(i + 100);
+			REQUIRE(f.peek() == i);
+			f.dequeue();
+			REQUIRE(f.peek() == i + 100);
+			f.dequeue();
+		}
+		f.enqueue(1); f.enqueue(2); f.enqueue(3);
+		REQUIRE_THROWS_AS(f.enqueue(4), std::overflow_error);
+		REQUIRE(f.size() == 3);
+		f.clear();
+		REQUIRE_THROWS_AS(f.dequeue(), std::underflow_error);
+	}
+
+	SECTION("Test Growable Unrolls Wrap In Order")
+	{
+		Queue<std::string, CheckedBounds, GrowableCapacity> g(4);
+		g.enqueue("a"); g.enqueue("b"); g.enqueue("c");
+		g.dequeue(); g.dequeue();
+		for (int i = 0; i < 20; i++) {		// wrapped when it first grows
+			g.enqueue(std::to_string(i));
+		}
+		REQUIRE(g.size() == 21);
+		REQUIRE(g.capacity() == 32);
+		REQUIRE(g.peek() == "c");
+		g.dequeue();
+		for (int i = 0; i < 20; i++) {
+			REQUIRE(g.peek() == std::to_string(i));
+			g.dequeue();
+		}
+		REQUIRE(g.isEmpty());
+	}
+
+	SECTION("Test Bulk Enqueue And Dequeue Across Wrap")
+	{
+		Queue<int, CheckedBounds, GrowableCapacity> g(8);
+		int in[20], out[20];
+		for (int i = 0; i < 20; i++) {
+			in[i] = i;
+		}
+		REQUIRE(g.enqueueN(in, 6) == 6);
+		REQUIRE(g.dequeueN(out, 5) == 5);
+		REQUIRE(out[4] == 4);
+		REQUIRE(g.enqueueN(in + 6, 6) == 6);	// wraps within the buffer
+		REQUIRE(g.capacity() == 8);
+		REQUIRE(g.enqueueN(in + 12, 8) == 8);	// grows
+		REQUIRE(g.size() == 15);
+		REQUIRE(g.dequeueN(out, 20) == 15);
+		for (int i = 0; i < 15; i++) {
+			REQUIRE(out[i] == i + 5);
+		}
+		REQUIRE(g.dequeueN(out, 1) == 0);
+
+		Queue<int> f(5);
+		REQUIRE(f.enqueueN(in, 8) == 5);		// fixed capacity takes what fits
+		REQUIRE(f.dequeueN(out, 3) == 3);
+		REQUIRE(f.enqueueN(in + 5, 8) == 3);
+		REQUIRE(f.dequeueN(out, 8) == 5);
+		REQUIRE(out[0] == 3);
+		REQUIRE(out[4] == 7);
+	}
 }
 
 /**
@@ -387,6 +798,23 @@ TEST_CASE("Database Axioms", "[Database]")
 		REQUIRE(d.size() == r.size());
 		REQUIRE(d.get() == r.get());
 	}
+
+	SECTION("Test Save Keeps Position And Sharing")
+	{
+		CowDatabase<std::string> d;
+		d.add("a"); d.add("b"); d.add("c");
+		d.first(); d.next();
+		CowDatabase<std::string> copy(d);
+		d.save(std::string{ "test.txt" });
+
+		REQUIRE(d.get() == "b");
+
+		Database<std::string> r;
+		r.load(std::string{ "test.txt" });
+		REQUIRE(r.size() == 3);
+		r.last();
+		REQUIRE(r.get() == "c");
+	}
 }
 
 /**
@@ -571,6 +999,220 @@ TEST_CASE("LinkedList Axioms", "[LinkedList]")
 			REQUIRE(true == true);
 		}
 	}
+
+	SECTION("Test Assign Longer To Shorter And Back")
+	{
+		LinkedList<std::string> a, b;
+		for (int i = 0; i < 10; i++) {
+			a.add(std::to_string(i));
+		}
+		b.add("x");
+		b = a;
+		REQUIRE(b.size() == 10);
+		REQUIRE(b.get(9) == "9");
+		b.add("10");
+		REQUIRE(b.get(10) == "10");
+
+		LinkedList<std::string> c;
+		c.add("y");
+		b = c;
+		REQUIRE(b.size() == 1);
+		REQUIRE(b.get(0) == "y");
+		b.add("z");
+		REQUIRE(b.get(1) == "z");
+
+		b = b;
+		REQUIRE(b.size() == 2);
+		b = LinkedList<std::string>();
+		REQUIRE(b.isEmpty());
+	}
+
+	SECTION("Test Clear And Destroy Large List")
+	{
+		LinkedList<int> big;
+		for (int i = 0; i < 200000; i++) {
+			big.add(i);
+		}
+		LinkedList<int> copy(big);
+		big.clear();
+		REQUIRE(big.isEmpty());
+		big = copy;
+		REQUIRE(big.size() == 200000);
+		REQUIRE(big.get(199999) == 199999);
+	}
+
+	SECTION("Test Iterator Insert And Erase")
+	{
+		LinkedList<int> a;
+		ListIterator<int> it = a.insertAfter(a.beforeBegin(), 2);
+		ListIterator<int> four = a.insertAfter(it, 4);
+		a.insertBefore(a.begin(), 1);
+		a.insertBefore(a.end(), 5);
+		a.insertBefore(four, 3);
+		REQUIRE(a.size() == 5);
+		for (int i = 0; i < 5; i++) {
+			REQUIRE(a.get(i) == i + 1);
+		}
+
+		it = a.erase(a.begin());
+		REQUIRE(*it == 2);
+		a.eraseAfter(it);
+		REQUIRE(a.get(1) == 4);
+		it = a.begin();
+		a.erase(++it);
+		REQUIRE(a.size() == 2);
+		REQUIRE(a.get(1) == 5);
+		a.add(6);
+		REQUIRE(a.get(2) == 6);
+		REQUIRE_THROWS_AS(a.erase(a.end()), std::out_of_range);
+	}
+
+	SECTION("Test Splice Between Lists Outliving Source")
+	{
+		LinkedList<std::string> dest;
+		dest.add("a"); dest.add("e");
+		{
+			LinkedList<std::string> src;
+			src.add("x"); src.add("b"); src.add("c"); src.add("d"); src.add("y");
+			ListIterator<std::string> first = ++src.begin();
+			ListIterator<std::string> last = first;
+			++last; ++last; ++last;
+			dest.splice(++dest.begin(), src, first, last);
+
+			REQUIRE(src.size() == 2);
+			REQUIRE(src.get(1) == "y");
+			src.add("z");
+			REQUIRE(src.get(2) == "z");
+		}
+		REQUIRE(dest.size() == 5);
+		std::string joined;
+		for (ListIterator<std::string> i = dest.begin(); i != dest.end(); ++i) {
+			joined += *i;
+		}
+		REQUIRE(joined == "abcde");
+		dest.remove(1);
+		dest.add("f");
+		REQUIRE(dest.get(4) == "f");
+	}
+
+	SECTION("Test Splice Whole List And Within List")
+	{
+		LinkedList<int> a, b;
+		a.add(1); a.add(2);
+		b.add(3); b.add(4);
+		a.splice(a.end(), b);
+		REQUIRE(b.isEmpty());
+		REQUIRE(a.size() == 4);
+		REQUIRE(a.get(3) == 4);
+
+		// move first element to the end of the same list
+		a.splice(a.end(), a, a.begin(), ++a.begin());
+		REQUIRE(a.get(0) == 2);
+		REQUIRE(a.get(3) == 1);
+		a.add(5);
+		REQUIRE(a.get(4) == 5);
+		b.add(9);
+		REQUIRE(b.get(0) == 9);
+
+		// a range spliced to where it already is, pos == last, leaves the list unchanged
+		a.splice(a.end(), a, a.begin(), a.end());
+		ListIterator<int> third = ++(++a.begin());
+		a.splice(third, a, a.begin(), third);
+		int n = 0;
+		for (ListIterator<int> it = a.begin(); it != a.end(); ++it) {
+			REQUIRE(*it == a.get(n++));
+		}
+		REQUIRE(n == 5);
+		REQUIRE(a.get(0) == 2);
+		REQUIRE(a.get(4) == 5);
+	}
+
+	SECTION("Test Positional Access Tracks Edits")
+	{
+		LinkedList<int> a;
+		ArrayList<int> model;
+		for (int i = 0; i < 200; i++) {
+			a.add(i);
+			model.add(i);
+		}
+		for (int i = 0; i < 200; i += 7) {	// positions kept in step by add and remove
+			a.add(i, -i);
+			model.add(i, -i);
+			a.remove(i + 3);
+			model.remove(i + 3);
+			REQUIRE(a.get(i + 1) == model.get(i + 1));
+		}
+		for (int i = model.size() - 1; i >= 0; i -= 3) {	// walking backwards
+			REQUIRE(a.get(i) == model.get(i));
+		}
+		a.erase(a.begin());							// iterator edits forget the cursor
+		model.remove(0);
+		a.insertBefore(a.end(), 1000);
+		model.add(1000);
+		for (int i = 0; i < model.size(); i++) {
+			REQUIRE(a.get(i) == model.get(i));
+			a.set(i, i);
+		}
+		LinkedList<int> b(a);
+		REQUIRE(b == a);
+		b.set(b.size() / 2, -1);
+		REQUIRE_FALSE(b == a);
+		a.clear();
+		a.add(5);
+		REQUIRE(a.get(0) == 5);
+	}
+
+	SECTION("Test Sort And Merge")
+	{
+		LinkedList<int> a;
+		ArrayList<int> model;
+		unsigned seed = 12345;
+		for (int i = 0; i < 5000; i++) {
+			seed = seed * 1103515245 + 12345;
+			int v = (seed >> 8) % 1000 * 10 + i % 10;	// tens digit ties, units record order
+			a.add(v);
+			model.add(v);
+		}
+		auto byTens = [](int x, int y) { return x / 10 < y / 10; };
+		a.sort(byTens);
+		std::stable_sort(model.begin(), model.end(), byTens);
+		int i = 0;
+		for (ListIterator<int> itr = a.begin(); itr != a.end(); ++itr, i++) {
+			REQUIRE(*itr == model.get(i));
+		}
+		REQUIRE(i == 5000);
+		a.sort();
+		for (i = 1; i < 5000; i++) {
+			REQUIRE(a.get(i - 1) <= a.get(i));
+		}
+		a.sort(std::greater<int>());
+		REQUIRE(a.get(0) >= a.get(4999));
+
+		LinkedList<int> odd, even;
+		for (int v = 9; v >= 1; v -= 2) {
+			odd.add(v);
+			even.add(v + 1);
+		}
+		odd.sort();
+		even.sort();
+		odd.merge(even);
+		REQUIRE(even.isEmpty());
+		REQUIRE(odd.size() == 10);
+		for (int v = 0; v < 10; v++) {
+			REQUIRE(odd.get(v) == v + 1);
+		}
+		odd.add(11);
+		REQUIRE(odd.get(10) == 11);
+		even.merge(odd);
+		REQUIRE(odd.isEmpty());
+		REQUIRE(even.get(10) == 11);
+		odd.add(1);
+		even.merge(odd);							// last element stays last
+		even.add(12);
+		REQUIRE(even.get(0) == 1);
+		REQUIRE(even.get(1) == 1);
+		REQUIRE(even.get(12) == 12);
+	}
 }
 
 /**
@@ -638,6 +1280,140 @@ TEST_CASE("DoubleLinkedList Axioms", "[DoubleLinkedList]")
 			REQUIRE(true == true);
 		}
 	}
+
+	SECTION("Test Iterator Insert And Erase")
+	{
+		DLinkedList<int> a;
+		DListIterator<int> it = a.insertBefore(a.end(), 3);
+		a.insertBefore(it, 1);
+		a.insertAfter(it, 4);
+		a.insertAfter(a.begin(), 2);
+		REQUIRE(a.size() == 4);
+		for (int i = 0; i < 4; i++) {
+			REQUIRE(a.get(i) == i + 1);
+		}
+		it = a.erase(it);
+		REQUIRE(*it == 4);
+		REQUIRE(a.size() == 3);
+		REQUIRE(a.get(2) == 4);
+		REQUIRE_THROWS_AS(a.erase(a.end()), std::out_of_range);
+	}
+
+	SECTION("Test Splice Between Lists Outliving Source")
+	{
+		DLinkedList<std::string> dest;
+		dest.add("a"); dest.add("e");
+		{
+			DLinkedList<std::string> src;
+			src.add("b"); src.add("c"); src.add("d"); src.add("y");
+			DListIterator<std::string> last = src.end();
+			--last;
+			dest.splice(--dest.end(), src, src.begin(), last);
+			REQUIRE(src.size() == 1);
+			REQUIRE(src.get(0) == "y");
+		}
+		REQUIRE(dest.size() == 5);
+		REQUIRE(dest.get(1) == "b");
+		REQUIRE(dest.get(4) == "e");
+
+		DLinkedList<std::string> more;
+		more.add("f");
+		dest.splice(dest.end(), more);
+		REQUIRE(more.isEmpty());
+		REQUIRE(dest.get(5) == "f");
+		dest.splice(dest.begin(), dest, --dest.end(), dest.end());
+		REQUIRE(dest.get(0) == "f");
+		REQUIRE(dest.get(5) == "e");
+		dest.clear();
+		REQUIRE(dest.isEmpty());
+	}
+
+	SECTION("Test Positional Access Tracks Edits")
+	{
+		DLinkedList<int> a;
+		ArrayList<int> model;
+		for (int i = 0; i < 200; i++) {
+			a.add(i);
+			model.add(i);
+		}
+		for (int i = 0; i < 200; i += 7) {	// positions kept in step by add and remove
+			a.add(i, -i);
+			model.add(i, -i);
+			a.remove(i + 3);
+			model.remove(i + 3);
+			REQUIRE(a.get(i + 1) == model.get(i + 1));
+		}
+		for (int i = model.size() - 1; i >= 0; i -= 3) {	// walking backwards
+			REQUIRE(a.get(i) == model.get(i));
+		}
+		a.erase(a.begin());							// iterator edits forget the cursor
+		model.remove(0);
+		a.insertBefore(a.end(), 1000);
+		model.add(1000);
+		for (int i = 0; i < model.size(); i++) {
+			REQUIRE(a.get(i) == model.get(i));
+			a.set(i, i);
+		}
+		DLinkedList<int> b(a);
+		REQUIRE(b == a);
+		b.set(b.size() / 2, -1);
+		REQUIRE_FALSE(b == a);
+		a.clear();
+		a.add(5);
+		REQUIRE(a.get(0) == 5);
+	}
+
+	SECTION("Test Sort And Merge")
+	{
+		DLinkedList<int> a;
+		ArrayList<int> model;
+		unsigned seed = 12345;
+		for (int i = 0; i < 5000; i++) {
+			seed = seed * 1103515245 + 12345;
+			int v = (seed >> 8) % 1000 * 10 + i % 10;	// tens digit ties, units record order
+			a.add(v);
+			model.add(v);
+		}
+		auto byTens = [](int x, int y) { return x / 10 < y / 10; };
+		a.sort(byTens);
+		std::stable_sort(model.begin(), model.end(), byTens);
+		int i = 0;
+		for (DListIterator<int> itr = a.begin(); itr != a.end(); ++itr, i++) {
+			REQUIRE(*itr == model.get(i));
+		}
+		REQUIRE(i == 5000);
+		a.sort();
+		for (i = 1; i < 5000; i++) {
+			REQUIRE(a.get(i - 1) <= a.get(i));
+		}
+		a.sort(std::greater<int>());
+		REQUIRE(a.get(0) >= a.get(4999));
+
+		DLinkedList<int> odd, even;
+		for (int v = 9; v >= 1; v -= 2) {
+			odd.add(v);
+			even.add(v + 1);
+		}
+		odd.sort();
+		even.sort();
+		odd.merge(even);
+		REQUIRE(even.isEmpty());
+		REQUIRE(odd.size() == 10);
+		for (int v = 0; v < 10; v++) {
+			REQUIRE(odd.get(v) == v + 1);
+		}
+		odd.add(11);
+		REQUIRE(odd.get(10) == 11);
+		even.merge(odd);
+		REQUIRE(odd.isEmpty());
+		REQUIRE(even.get(10) == 11);
+		odd.add(1);
+		even.merge(odd);							// last element stays last
+		even.add(12);
+		REQUIRE(even.get(0) == 1);
+		REQUIRE(even.get(1) == 1);
+		REQUIRE(even.get(12) == 12);
+	}
 }
 
 /**
@@ -832,6 +1608,249 @@ TEST_CASE("ArrayList Axioms", "[ArrayList]")
 		REQUIRE(m.size() == 2);
 		REQUIRE(m.get(1) == 2);
 	}
+
+	SECTION("Test Unchecked List")
+	{
+		ArrayList<int, UncheckedBounds> u(0);
+		u.add(1); u.add(3); u.add(1, 2);
+		u.remove(0);
+
+		REQUIRE(u.size() == 2);
+		REQUIRE(u.get(0) == 2);
+		REQUIRE(u.reverse().get(0) == 3);
+	}
+
+	SECTION("Test AddAll In Middle")
+	{
+		l.add(1); l.add(5);
+		ArrayList<int> b(3); b.add(2); b.add(3); b.add(4);
+		l.addAll(1, b);
+
+		REQUIRE(l.size() == 5);
+		for (int i = 0; i < 5; i++) {
+			REQUIRE(l.get(i) == i + 1);
+		}
+		REQUIRE_THROWS_AS(l.addAll(7, b), std::out_of_range);
+	}
+
+	SECTION("Test AddAll Of Own Elements")
+	{
+		ArrayList<int> s(3);
+		s.add(1); s.add(2); s.add(3);
+		s.addAll(1, s.span());
+
+		REQUIRE(s.size() == 6);
+		REQUIRE(s.get(1) == 1);
+		REQUIRE(s.get(3) == 3);
+		REQUIRE(s.get(5) == 3);
+	}
+
+	SECTION("Test Add And Emplace Own Element Without Growing")
+	{
+		ArrayList<std::string> s(10);
+		s.add("a"); s.add("b"); s.add("c");
+		s.add(0, s[1]);
+		s.emplace(0, s[3]);
+		s.addAll(4, s.mid(1, 2));
+
+		REQUIRE(s.size() == 7);
+		REQUIRE(s.get(0) == "c");
+		REQUIRE(s.get(1) == "b");
+		REQUIRE(s.get(2) == "a");
+		REQUIRE(s.get(3) == "b");
+		REQUIRE(s.get(4) == "b");
+		REQUIRE(s.get(5) == "a");
+		REQUIRE(s.get(6) == "c");
+	}
+
+	SECTION("Test RemoveRange")
+	{
+		for (int i = 0; i < 10; i++) {
+			l.add(i);
+		}
+		l.removeRange(2, 8);
+
+		REQUIRE(l.size() == 4);
+		REQUIRE(l.get(1) == 1);
+		REQUIRE(l.get(2) == 8);
+		l.removeRange(4, 4);
+		REQUIRE(l.size() == 4);
+		REQUIRE_THROWS_AS(l.removeRange(3, 5), std::out_of_range);
+	}
+
+	SECTION("Test RemoveIf Keeps Order")
+	{
+		for (int i = 0; i < 10; i++) {
+			l.add(i);
+		}
+		REQUIRE(l.removeIf([](int v) { return v % 3 == 0; }) == 4);
+		REQUIRE(l.size() == 6);
+		REQUIRE(l.get(0) == 1);
+		REQUIRE(l.get(2) == 4);
+		REQUIRE(l.get(5) == 8);
+	}
+
+	SECTION("Test Emplace And Reserve With Strings")
+	{
+		ArrayList<std::string> s(0);
+		s.reserve(10);
+		s.add("b");
+		s.emplace(0, 3, 'a');
+		s.emplace(2, "c");
+		ArrayList<std::string> more(2); more.add("x"); more.add("y");
+		s.addAll(1, more);
+		s.removeRange(0, 1);
+
+		REQUIRE(s.size() == 4);
+		REQUIRE(s.get(0) == "x");
+		REQUIRE(s.get(2) == "b");
+		REQUIRE(s.get(3) == "c");
+		REQUIRE(s.removeIf([](const std::string & v) { return v == "b"; }) == 1);
+		REQUIRE(s.get(2) == "c");
+	}
+
+	SECTION("Test Iterators And References")
+	{
+		l.add(3); l.add(1); l.add(2);
+		int sum = 0;
+		for (int v : l) {
+			sum += v;
+		}
+		REQUIRE(sum == 6);
+		REQUIRE(l.end() - l.begin() == 3);
+		REQUIRE(l.data() == l.begin());
+
+		std::sort(l.begin(), l.end());
+		REQUIRE(l.get(0) == 1);
+		REQUIRE(l.get(2) == 3);
+
+		l[1] = 20;
+		REQUIRE(l.at(1) == 20);
+		REQUIRE(&l.at(2) == &l[2]);
+		REQUIRE_THROWS_AS(l.at(3), std::out_of_range);
+		REQUIRE_THROWS_AS(l[-1], std::out_of_range);
+	}
+}
+
+TEST_CASE("ArraySpan Axioms", "[ArraySpan]")
+{
+	ArrayList<int> l(8);
+	l.add(5); l.add(1); l.add(4); l.add(2); l.add(3); l.add(0);
+
+	SECTION("Test Views Share Elements")
+	{
+		ArraySpan<int> m = l.mid(1, 3);
+		REQUIRE(m.size() == 3);
+		REQUIRE(m.get(0) == 1);
+
+		m[0] = 9;
+		REQUIRE(l.get(1) == 9);
+		REQUIRE(l.drop(1).take(3) == m);
+	}
+
+	SECTION("Test Reverse Views")
+	{
+		ReverseSpan<int> r = l.reverse();
+		REQUIRE(r.get(0) == 0);
+		REQUIRE(r.take(2).get(1) == 3);
+		REQUIRE(r.drop(4).get(0) == 1);
+		REQUIRE(r.mid(1, 2).get(0) == 3);
+		REQUIRE(r.reverse() == l.span());
+	}
+
+	SECTION("Test Invalid Views")
+	{
+		REQUIRE_THROWS_AS(l.take(7), std::out_of_range);
+		REQUIRE_THROWS_AS(l.mid(4, 3), std::out_of_range);
+		REQUIRE_THROWS_AS(l.span()[6], std::out_of_range);
+	}
+
+	SECTION("Test Sort Subrange In Place")
+	{
+		quickSort(l.mid(1, 4));
+		ArrayList<int> sorted = l;
+		REQUIRE(sorted.get(0) == 5);
+		REQUIRE(isOrdered(l.mid(1, 4)) == true);
+		REQUIRE(sorted.get(5) == 0);
+
+		mergeSort(l.reverse());		// sorts the list into descending order
+		REQUIRE(isOrdered(l.reverse()) == true);
+		REQUIRE(l.get(0) == 5);
+	}
+
+	SECTION("Test Search Spans")
+	{
+		const ArrayList<int> & c = l;
+		REQUIRE(sequentialSearch(c.drop(2), 3) == 2);
+		REQUIRE(countOccurrence(c.reverse(), 4) == 1);
+
+		insertionSort(l.span());
+		REQUIRE(binarySearch(l.drop(2), 4) == 2);
+		REQUIRE(countOccurrenceOrdered(l.reverse(), 2) == 1);
+	}
+
+	SECTION("Test Span Of Array")
+	{
+		Array<int> a(5);
+		for (int i = 0; i < 5; i++) { a[i] = 5 - i; }
+		selectionSort(ArraySpan<int>(a).take(3));
+		REQUIRE(a[0] == 3);
+		REQUIRE(a[3] == 2);
+	}
+}
+
+TEST_CASE("ListView Axioms", "[ListView]")
+{
+	ArrayList<int> l(20);
+	for (int i = 1; i <= 10; i++) {
+		l.add(i);
+	}
+
+	SECTION("Test Fused Pipeline")
+	{
+		ArrayList<int> r = l.view()
+			.filter([](int v) { return v % 2 == 0; })
+			.map([](int v) { return v * 10; })
+			.drop(1)
+			.take(3)
+			.collect();
+
+		REQUIRE(r.size() == 3);
+		REQUIRE(r.get(0) == 40);
+		REQUIRE(r.get(2) == 80);
+	}
+
+	SECTION("Test Take Stops Early")
+	{
+		int visited = 0;
+		int n = l.view().filter([&](int) { visited++; return true; }).take(3).count();
+
+		REQUIRE(n == 3);
+		REQUIRE(visited == 3);
+	}
+
+	SECTION("Test Map Changes Type")
+	{
+		ArrayList<std::string> s = l.view().take(2).map([](int v) { return std::to_string(v); }).collect();
+		REQUIRE(s.get(1) == "2");
+	}
+
+	SECTION("Test Reverse")
+	{
+		REQUIRE(l.view().reverse().take(2).collect().get(1) == 9);
+		REQUIRE(l.view().filter([](int v) { return v < 4; }).reverse().collect().get(0) == 3);
+	}
+
+	SECTION("Test Empty And Out Of Range Stages")
+	{
+		REQUIRE(l.view().take(0).count() == 0);
+		REQUIRE(l.view().drop(20).count() == 0);
+		REQUIRE(l.view().take(20).count() == 10);
+
+		int sum = 0;
+		l.view().drop(8).forEach([&](int v) { sum += v; });
+		REQUIRE(sum == 19);
+	}
 }
 
 /**
@@ -873,6 +1892,44 @@ TEST_CASE("Ordered List Axioms", "[OrderedList]")
 		
 		REQUIRE(c == o);
 	}
+
+	SECTION("Test Ordered Iteration With Duplicates")
+	{
+		o.add(3); o.add(1); o.add(3); o.add(2); o.add(1);
+		int expected[] = { 1, 1, 2, 3, 3 };
+		int i = 0;
+		for (int v : o) {
+			REQUIRE(v == expected[i++]);
+		}
+		REQUIRE(o[2] == 2);
+		REQUIRE(o.first() == 1);
+		REQUIRE(o.last() == 3);
+		REQUIRE(o.find(2) == 2);
+	}
+
+	SECTION("Test Positional Inserts Are Invalid")
+	{
+		o.add(1); o.add(3);
+		ArrayList<int> a; a.add(0);
+		REQUIRE_THROWS_AS(o.emplace(2, 0), std::runtime_error);
+		REQUIRE_THROWS_AS(o.addAll(0, a), std::runtime_error);
+		REQUIRE_THROWS_AS(o.addAll(0, a.span()), std::runtime_error);
+		REQUIRE(o.removeIf([](int v) { return v == 1; }) == 1);
+		REQUIRE(o.size() == 1);
+		REQUIRE(o.find(3) == 0);
+	}
+
+	SECTION("Test Views Are Read Only")
+	{
+		o.add(2); o.add(1); o.add(3);
+		REQUIRE(std::is_same<decltype(o.reverse()), ReverseSpan<const int> >::value);
+		REQUIRE(std::is_same<decltype(o.span()), ArraySpan<const int> >::value);
+		REQUIRE(std::is_same<decltype(o.take(1)), ArraySpan<const int> >::value);
+		REQUIRE(std::is_same<decltype(o.drop(1)), ArraySpan<const int> >::value);
+		REQUIRE(std::is_same<decltype(o.mid(0, 1)), ArraySpan<const int> >::value);
+		REQUIRE(o.reverse().get(0) == 3);
+		REQUIRE(o.mid(1, 2).get(0) == 2);
+	}
 }
 
 /**
@@ -1121,6 +2178,18 @@ TEST_CASE("Ordered Search Axioms", "[Search]")
 		//assert that 100 is not found
 		REQUIRE(countOccurrenceOrdered<int>(oa,100) == 0);
 	} 
+
+	SECTION("Load From File Into Empty Array")
+	{
+		std::ofstream("load.txt") << "5 10 13";
+		Array<int> ea(0);
+		loadFromFile(ea, "load.txt");
+		std::remove("load.txt");
+
+		REQUIRE(ea.length() == 3);
+		REQUIRE(ea[0] == 5);
+		REQUIRE(ea[2] == 13);
+	}
 }
 
 
@@ -1207,6 +2276,1190 @@ TEST_CASE("UnOrdered Search Axioms", "[Search]")
 
 }
 
+TEST_CASE("NodePool Axioms", "[NodePool]")
+{
+	SECTION("Test Destroyed Slot Is Reused")
+	{
+		NodePool< Node<int> > pool;
+		Node<int>* a = pool.create(1);
+		Node<int>* b = pool.create(2, a);
+		REQUIRE(pool.live() == 2);
+		REQUIRE(b->next == a);
+
+		pool.destroy(a);
+		Node<int>* c = pool.create(3);
+		REQUIRE(c == a);
+		REQUIRE(c->data == 3);
+		pool.destroy(b);
+		pool.destroy(c);
+		REQUIRE(pool.live() == 0);
+	}
+
+	SECTION("Test Slabs Grow Then Reset Keeps Largest")
+	{
+		NodePool< Node<int> > pool;
+		for (int i = 0; i < 100; i++) {
+			pool.create(i);
+		}
+		REQUIRE(pool.capacity() >= 100);
+		pool.reset();
+		REQUIRE(pool.live() == 0);
+		REQUIRE(pool.capacity() == 64);
+		REQUIRE(pool.discardIsTrivial());
+	}
+
+	SECTION("Test Merged Pools Share Slabs")
+	{
+		NodePool< Node<int> > a, b, c;
+		Node<int>* x = a.create(1);
+		Node<int>* y = b.create(2);
+		Node<int>* z = c.create(3);
+		b.merge(c);
+		a.merge(b);
+		a.merge(c);					// already merged through b
+		c.destroy(x);				// any pool may release nodes of the others
+		a.destroy(y);
+		b.destroy(z);
+
+		b.reset();					// shared, so b leaves without a slab
+		REQUIRE(b.capacity() == 0);
+		Node<int>* w = a.create(4);
+		c.reset();
+		REQUIRE(w->data == 4);
+		a.destroy(w);
+		a.reset();					// a alone now, so keeps its slab
+		REQUIRE(a.capacity() == 16);
+	}
+
+	SECTION("Test Splices Leave Nodes Valid After Source Is Gone")
+	{
+		LinkedList<int> keep;
+		for (int round = 0; round < 200; round++) {
+			LinkedList<int> source;
+			for (int i = 0; i < 10; i++) {
+				source.add(round * 10 + i);
+			}
+			keep.splice(keep.begin(), source);
+		}
+		REQUIRE(keep.size() == 2000);
+		REQUIRE(keep.get(0) == 1990);
+		REQUIRE(keep.get(1999) == 9);
+	}
+
+	SECTION("Test Pooled Containers With Strings")
+	{
+		LinkedList<std::string> l;
+		DLinkedList<std::string> d;
+		BinaryTree<std::string> t;
+		for (int i = 0; i < 100; i++) {
+			l.add(std::to_string(i));
+			d.add(0, std::to_string(i));
+			t.insert(std::to_string(i));
+		}
+		l.remove(50); d.remove(50); t.remove("50");
+		LinkedList<std::string> lc(l);
+		BinaryTree<std::string> tc(t);
+		l.clear(); d.clear(); t.clear();
+
+		REQUIRE(l.isEmpty());
+		REQUIRE(d.isEmpty());
+		REQUIRE(t.isEmpty());
+		REQUIRE(lc.size() == 99);
+		REQUIRE(lc.get(98) == "99");
+		REQUIRE(tc.find("99"));
+		REQUIRE_FALSE(tc.find("50"));
+
+		l.add("again"); d.add("again"); t.insert("again");
+		REQUIRE(l.get(0) == "again");
+		REQUIRE(d.get(0) == "again");
+		REQUIRE(t.find("again"));
+	}
+
+	SECTION("Test Heap Allocated Nodes")
+	{
+		LinkedList<int, HeapNodes< Node<int> > > l;
+		DLinkedList<int, HeapNodes< DNode<int> > > d;
+		for (int i = 0; i < 10; i++) {
+			l.add(i);
+			d.add(i);
+		}
+		l.remove(0); d.remove(9);
+		REQUIRE(l.get(0) == 1);
+		REQUIRE(d.get(8) == 8);
+		l.clear(); d.clear();
+		REQUIRE(l.size() == 0);
+		REQUIRE(d.size() == 0);
+	}
+}
+
+TEST_CASE("UnrolledList Axioms", "[UnrolledList]")
+{
+	UnrolledList<int, 4> l;
+
+	SECTION("Test Add Get Set")
+	{
+		for (int i = 0; i < 10; i++) {
+			l.add(i);
+		}
+		REQUIRE(l.size() == 10);
+		REQUIRE(l.blocks() == 3);
+		REQUIRE(l.get(9) == 9);
+		l.set(5, 50);
+		REQUIRE(l.get(5) == 50);
+		REQUIRE(l.find(50) == 5);
+		REQUIRE(l.find(99) == -1);
+		REQUIRE_THROWS_AS(l.get(10), std::out_of_range);
+	}
+
+	SECTION("Test Middle Insert Splits Block")
+	{
+		for (int i = 0; i < 4; i++) {
+			l.add(i);
+		}
+		l.add(1, 10);
+		REQUIRE(l.blocks() == 2);
+		int expected[] = { 0, 10, 1, 2, 3 };
+		int i = 0;
+		for (int v : l) {
+			REQUIRE(v == expected[i++]);
+		}
+	}
+
+	SECTION("Test Matches ArrayList Under Churn")
+	{
+		UnrolledList<std::string, 4> u;
+		ArrayList<std::string> a;
+		unsigned seed = 7;
+		for (int step = 0; step < 2000; step++) {
+			seed = seed * 1103515245u + 12345u;
+			int r = (int)(seed >> 8);
+			if (a.size() > 0 && r % 3 == 0) {
+				int pos = r % a.size();
+				u.remove(pos);
+				a.remove(pos);
+			} else {
+				int pos = r % (a.size() + 1);
+				u.add(pos, std::to_string(step));
+				a.add(pos, std::to_string(step));
+			}
+		}
+		REQUIRE(u.size() == a.size());
+		for (int i = 0; i < a.size(); i++) {
+			REQUIRE(u.get(i) == a.get(i));
+		}
+		REQUIRE(u.blocks() <= a.size() / 2 + 1);
+	}
+
+	SECTION("Test Remove Releases Blocks")
+	{
+		for (int i = 0; i < 12; i++) {
+			l.add(i);
+		}
+		for (int i = 0; i < 12; i++) {
+			l.remove(0);
+		}
+		REQUIRE(l.isEmpty());
+		REQUIRE(l.blocks() == 0);
+		l.add(0, 1);
+		REQUIRE(l.get(0) == 1);
+	}
+
+	SECTION("Test Copy Assign And Equal")
+	{
+		for (int i = 0; i < 10; i++) {
+			l.add(0, i);
+		}
+		UnrolledList<int, 4> c(l);
+		REQUIRE(c == l);
+		c.set(0, -1);
+		REQUIRE(c != l);
+		c = l;
+		REQUIRE(c == l);
+		c.clear();
+		REQUIRE(c.size() == 0);
+	}
+}
+
+TEST_CASE("SkipList Axioms", "[SkipList]")
+{
+	SkipList<int> s;
+
+	SECTION("Test Add Get Set")
+	{
+		for (int i = 0; i < 100; i++) {
+			s.add(i);
+		}
+		REQUIRE(s.size() == 100);
+		REQUIRE(s.get(0) == 0);
+		REQUIRE(s.get(99) == 99);
+		s.set(50, -1);
+		REQUIRE(s.get(50) == -1);
+		REQUIRE(s.find(-1) == 50);
+		REQUIRE_THROWS_AS(s.get(100), std::out_of_range);
+		REQUIRE_THROWS_AS(s.add(101, 1), std::out_of_range);
+	}
+
+	SECTION("Test LinkedList Iterator")
+	{
+		s.add(1); s.add(0, 0); s.add(2);
+		int i = 0;
+		for (ListIterator<int> itr = s.begin(); itr != s.end(); ++itr) {
+			REQUIRE(*itr == i++);
+		}
+		REQUIRE(i == 3);
+	}
+
+	SECTION("Test Matches ArrayList Under Churn")
+	{
+		SkipList<std::string> k;
+		ArrayList<std::string> a;
+		unsigned seed = 11;
+		for (int step = 0; step < 3000; step++) {
+			seed = seed * 1103515245u + 12345u;
+			int r = (int)(seed >> 8);
+			if (a.size() > 0 && r % 3 == 0) {
+				int pos = r % a.size();
+				k.remove(pos);
+				a.remove(pos);
+			} else {
+				int pos = r % (a.size() + 1);
+				k.add(pos, std::to_string(step));
+				a.add(pos, std::to_string(step));
+			}
+		}
+		REQUIRE(k.size() == a.size());
+		for (int i = 0; i < a.size(); i++) {
+			REQUIRE(k.get(i) == a.get(i));
+		}
+		int i = 0;
+		for (const std::string & v : k) {
+			REQUIRE(v == a.get(i++));
+		}
+	}
+
+	SECTION("Test Copy Assign And Clear")
+	{
+		for (int i = 0; i < 20; i++) {
+			s.add(0, i);
+		}
+		SkipList<int> c(s);
+		REQUIRE(c == s);
+		c.remove(0);
+		REQUIRE(c != s);
+		c = s;
+		REQUIRE(c == s);
+		s.clear();
+		REQUIRE(s.isEmpty());
+		s.add(0, 5);
+		REQUIRE(s.get(0) == 5);
+	}
+}
+
+TEST_CASE("ConcurrentLinkedList Axioms", "[ConcurrentLinkedList]")
+{
+	ConcurrentLinkedList<int> c;
+
+	SECTION("Test Sorted Set Operations")
+	{
+		REQUIRE(c.isEmpty());
+		REQUIRE(c.add(3));
+		REQUIRE(c.add(1));
+		REQUIRE(c.add(2));
+		REQUIRE_FALSE(c.add(2));
+		REQUIRE(c.size() == 3);
+		REQUIRE(c.contains(1));
+		REQUIRE_FALSE(c.contains(4));
+		std::stringstream ss;
+		ss << c;
+		REQUIRE(ss.str() == "[ 1 2 3 ]");
+
+		REQUIRE(c.remove(2));
+		REQUIRE_FALSE(c.remove(2));
+		REQUIRE_FALSE(c.contains(2));
+		REQUIRE(c.size() == 2);
+		REQUIRE(c.add(2));
+		REQUIRE(c.contains(2));
+	}
+
+	SECTION("Test Many Adds And Removes Reclaim Nodes")
+	{
+		ConcurrentLinkedList<std::string> s;
+		for (int round = 0; round < 20; round++) {
+			for (int i = 0; i < 100; i++) {
+				REQUIRE(s.add(std::to_string(i)));
+			}
+			for (int i = 0; i < 100; i++) {
+				REQUIRE(s.remove(std::to_string(i)));
+			}
+		}
+		REQUIRE(s.isEmpty());
+	}
+
+	SECTION("Test Stress Threads Contending")
+	{
+		const int THREADS = 4, KEYS = 2000;
+		std::atomic<int> added(0), removed(0), ready(0);
+		std::vector<std::thread> workers;
+		for (int t = 0; t < THREADS; t++) {
+			workers.emplace_back([&c, &added, &removed, &ready, t]() {
+				// every thread races for every key, then all remove the even ones
+				for (int k = 0; k < KEYS; k++) {
+					int key = (k * 7 + t * 13) % KEYS;
+					if (c.add(key)) { added++; }
+				}
+				ready++;
+				while (ready < THREADS) {
+					std::this_thread::yield();
+				}
+				for (int k = 0; k < KEYS; k += 2) {
+					if (c.remove((k + t * 2) % KEYS)) { removed++; }
+					c.contains(k + 1);
+				}
+			});
+		}
+		for (std::thread & w : workers) {
+			w.join();
+		}
+		REQUIRE(added == KEYS);
+		REQUIRE(removed == KEYS / 2);
+		REQUIRE(c.size() == KEYS / 2);
+		for (int k = 0; k < KEYS; k++) {
+			REQUIRE(c.contains(k) == (k % 2 == 1));
+		}
+	}
+}
+
+// Throughput against a LinkedList behind one mutex - run with [benchmark]
+TEST_CASE("ConcurrentLinkedList Throughput", "[.][benchmark]")
+{
+	const int KEYS = 512, OPS = 200000;
+	LinkedList<int> locked;
+	std::mutex lock;
+	ConcurrentLinkedList<int> lockFree;
+
+	// sorted set operations on the locked LinkedList, op 0 add, 1 remove, otherwise find
+	auto lockedOp = [&locked, &lock](int op, int key) {
+		std::lock_guard<std::mutex> hold(lock);
+		ListIterator<int> prev = locked.beforeBegin(), itr = locked.begin();
+		while (itr != locked.end() && *itr < key) {
+			prev = itr++;
+		}
+		bool found = itr != locked.end() && *itr == key;
+		if (op == 0 && !found) {
+			locked.insertAfter(prev, key);
+		} else if (op == 1 && found) {
+			locked.eraseAfter(prev);
+		}
+		return found;
+	};
+	auto lockFreeOp = [&lockFree](int op, int key) {
+		return op == 0 ? lockFree.add(key) : op == 1 ? lockFree.remove(key) : lockFree.contains(key);
+	};
+	// 10% add, 10% remove, 80% find on random keys, returns operations per second
+	auto run = [](int threads, const std::function<bool(int, int)> & f) {
+		std::vector<std::thread> workers;
+		auto start = std::chrono::steady_clock::now();
+		for (int t = 0; t < threads; t++) {
+			workers.emplace_back([&f, threads, t]() {
+				unsigned seed = 7 + t;
+				for (int i = 0; i < OPS / threads; i++) {
+					seed = seed * 1103515245u + 12345u;
+					int r = (int)(seed >> 8);
+					f(r % 10, (r / 10) % KEYS);
+				}
+			});
+		}
+		for (std::thread & w : workers) {
+			w.join();
+		}
+		std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+		return OPS / secs.count();
+	};
+
+	for (int k = 0; k < KEYS; k += 2) {
+		lockedOp(0, k);
+		lockFree.add(k);
+	}
+	for (int threads = 1; threads <= 8; threads *= 2) {
+		double m = run(threads, lockedOp);
+		double f = run(threads, lockFreeOp);
+		std::cout << threads << " threads: mutex LinkedList " << (long)m << " ops/s, ConcurrentLinkedList "
+			<< (long)f << " ops/s" << std::endl;
+	}
+	REQUIRE(lockFree.size() <= KEYS);
+}
+
+TEST_CASE("SpscQueue Axioms", "[SpscQueue]")
+{
+	SpscQueue<std::string> q(3);
+
+	SECTION("Test Queue Semantics")
+	{
+		REQUIRE(q.isEmpty());
+		REQUIRE(q.capacity() == 3);
+		q.enqueue("apple");
+		q.enqueue("orange");
+		q.enqueue("pear");
+		REQUIRE_THROWS_AS(q.enqueue("plum"), std::overflow_error);
+		REQUIRE_FALSE(q.tryEnqueue("plum"));
+		REQUIRE(q.size() == 3);
+		REQUIRE(q.peek() == "apple");
+		q.dequeue();
+		std::string s;
+		REQUIRE(q.tryDequeue(s));
+		REQUIRE(s == "orange");
+		q.clear();
+		REQUIRE(q.isEmpty());
+		REQUIRE_THROWS_AS(q.peek(), std::underflow_error);
+		REQUIRE_THROWS_AS(q.dequeue(), std::underflow_error);
+		REQUIRE_FALSE(q.tryDequeue(s));
+	}
+
+	SECTION("Test Batches Wrap The Ring")
+	{
+		SpscQueue<int> b(6);
+		int in[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }, out[10];
+		REQUIRE(b.enqueueN(in, 5) == 5);
+		REQUIRE(b.dequeueN(out, 4) == 4);
+		REQUIRE(b.enqueueN(in + 5, 10) == 5);		// wraps, capacity 6 not 8
+		REQUIRE(b.dequeueN(out, 10) == 6);
+		for (int i = 0; i < 6; i++) {
+			REQUIRE(out[i] == i + 4);
+		}
+	}
+
+	SECTION("Test Producer To Consumer Thread In Order")
+	{
+		const int N = 100000;
+		SpscQueue<int> h(64);
+		long long sum = 0;
+		bool inOrder = true;
+		std::thread consumer([&h, &sum, &inOrder]() {
+			int expected = 0, batch[16], v;
+			while (expected < N) {
+				int got = 0;
+				if (expected % 3 == 0) {
+					got = h.dequeueN(batch, 16);
+				} else if (h.tryDequeue(v)) {
+					batch[0] = v;
+					got = 1;
+				}
+				for (int i = 0; i < got; i++, expected++) {
+					inOrder = inOrder && batch[i] == expected;
+					sum += batch[i];
+				}
+				if (got == 0) {
+					std::this_thread::yield();
+				}
+			}
+		});
+		int items[8];
+		for (int next = 0; next < N; ) {
+			if (next % 2 == 0) {
+				int n = std::min(8, N - next);
+				for (int i = 0; i < n; i++) {
+					items[i] = next + i;
+				}
+				next += h.enqueueN(items, n);
+			} else if (h.tryEnqueue(next)) {
+				next++;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+		consumer.join();
+		REQUIRE(inOrder);
+		REQUIRE(sum == (long long)N * (N - 1) / 2);
+		REQUIRE(h.isEmpty());
+	}
+}
+
+// Handoff rate and round trip latency against a Queue behind a mutex - run with [benchmark]
+TEST_CASE("SpscQueue Throughput", "[.][benchmark]")
+{
+	const int N = 2000000, BATCH = 64;
+	typedef std::chrono::steady_clock Clock;
+
+	// producer hands 0..N-1 to a consumer thread, returns elements per second
+	auto handoff = [](const std::function<bool(int)> & put, const std::function<bool(int &)> & take) {
+		auto start = Clock::now();
+		std::thread consumer([&take]() {
+			int v;
+			for (int i = 0; i < N; ) {
+				if (take(v)) { i++; } else { std::this_thread::yield(); }
+			}
+		});
+		for (int i = 0; i < N; ) {
+			if (put(i)) { i++; } else { std::this_thread::yield(); }
+		}
+		consumer.join();
+		std::chrono::duration<double> secs = Clock::now() - start;
+		return N / secs.count();
+	};
+
+	Queue<int> locked(1024);
+	std::mutex lock;
+	double m = handoff(
+		[&](int v) { std::lock_guard<std::mutex> hold(lock); if (locked.size() == locked.capacity()) { return false; } locked.enqueue(v); return true; },
+		[&](int & v) { std::lock_guard<std::mutex> hold(lock); if (locked.isEmpty()) { return false; } v = locked.peek(); locked.dequeue(); return true; });
+
+	SpscQueue<int> spsc(1024);
+	double f = handoff([&](int v) { return spsc.tryEnqueue(v); }, [&](int & v) { return spsc.tryDequeue(v); });
+
+	// batches of BATCH each way, published with one store
+	auto start = Clock::now();
+	std::thread consumer([&spsc]() {
+		int batch[BATCH];
+		for (int i = 0; i < N; ) {
+			int got = spsc.dequeueN(batch, BATCH);
+			if (got == 0) { std::this_thread::yield(); }
+			i += got;
+		}
+	});
+	int batch[BATCH];
+	for (int i = 0; i < N; ) {
+		for (int k = 0; k < BATCH; k++) {
+			batch[k] = i + k;
+		}
+		int put = spsc.enqueueN(batch, std::min(BATCH, N - i));
+		if (put == 0) { std::this_thread::yield(); }
+		i += put;
+	}
+	consumer.join();
+	std::chrono::duration<double> secs = Clock::now() - start;
+	double b = N / secs.count();
+
+	// ping pong through a pair of queues, one element in flight
+	const int TRIPS = 20000;
+	SpscQueue<int> ping(16), pong(16);
+	start = Clock::now();
+	std::thread echo([&ping, &pong]() {
+		int v;
+		for (int i = 0; i < TRIPS; i++) {
+			while (!ping.tryDequeue(v)) { std::this_thread::yield(); }
+			while (!pong.tryEnqueue(v)) { std::this_thread::yield(); }
+		}
+	});
+	for (int i = 0; i < TRIPS; i++) {
+		int v;
+		ping.enqueue(i);
+		while (!pong.tryDequeue(v)) { std::this_thread::yield(); }
+	}
+	echo.join();
+	std::chrono::duration<double, std::nano> trip = (Clock::now() - start) / TRIPS;
+
+	std::cout << "mutex Queue " << (long)m << " /s, SpscQueue " << (long)f << " /s, SpscQueue batched "
+		<< (long)b << " /s, round trip " << (long)trip.count() << " ns" << std::endl;
+	REQUIRE(spsc.isEmpty());
+}
+
+TEST_CASE("MpmcQueue Axioms", "[MpmcQueue]")
+{
+	MpmcQueue<std::string> q(4);
+
+	SECTION("Test Queue Semantics")
+	{
+		REQUIRE(q.isEmpty());
+		REQUIRE(q.capacity() == 4);
+		for (int i = 0; i < 4; i++) {
+			REQUIRE(q.tryEnqueue(std::to_string(i)));
+		}
+		REQUIRE_FALSE(q.tryEnqueue("full"));
+		REQUIRE(q.size() == 4);
+		std::string s;
+		for (int lap = 0; lap < 10; lap++) {			// reuses every slot several times
+			REQUIRE(q.tryDequeue(s));
+			REQUIRE(s == std::to_string(lap));
+			q.enqueue(std::to_string(lap + 4));
+		}
+		for (int i = 10; i < 14; i++) {
+			q.dequeue(s);
+			REQUIRE(s == std::to_string(i));
+		}
+		REQUIRE_FALSE(q.tryDequeue(s));
+		REQUIRE(q.isEmpty());
+	}
+
+	SECTION("Test Capacity Is The Size Requested")
+	{
+		MpmcQueue<int> h(100), one(1);
+		REQUIRE(h.capacity() == 100);
+		REQUIRE(one.capacity() == 1);
+		int v;
+		for (int lap = 0; lap < 3; lap++) {
+			int n = 0;
+			while (h.tryEnqueue(n)) {
+				n++;
+			}
+			REQUIRE(n == 100);
+			REQUIRE(h.size() == 100);
+			for (int i = 0; i < 60; i++) {
+				REQUIRE(h.tryDequeue(v));
+				REQUIRE(v == i);
+			}
+			while (h.tryDequeue(v)) {}
+		}
+		REQUIRE(one.tryEnqueue(7));
+		REQUIRE_FALSE(one.tryEnqueue(8));
+		REQUIRE(one.tryDequeue(v));
+		REQUIRE(v == 7);
+		REQUIRE(one.tryEnqueue(8));
+	}
+
+	SECTION("Test Many Producers And Consumers")
+	{
+		const int PRODUCERS = 3, CONSUMERS = 3, EACH = 20000;
+		MpmcQueue<int> m(60);		// not a power of two, so the limit is checked
+		std::atomic<long long> sum(0);
+		std::atomic<int> taken(0);
+		std::atomic<bool> ordered(true);
+		std::vector<std::thread> threads;
+		for (int p = 0; p < PRODUCERS; p++) {
+			threads.emplace_back([&m, p]() {
+				for (int i = 0; i < EACH; i++) {
+					m.enqueue(p * EACH + i);
+				}
+			});
+		}
+		for (int c = 0; c < CONSUMERS; c++) {
+			threads.emplace_back([&m, &sum, &taken, &ordered]() {
+				int last[PRODUCERS] = { -1, -1, -1 }, v;
+				while (taken.load() < PRODUCERS * EACH) {
+					if (m.tryDequeue(v)) {
+						taken++;
+						sum += v;
+						// each consumer sees each producer's elements in the order enqueued
+						if (v % EACH <= last[v / EACH]) { ordered = false; }
+						last[v / EACH] = v % EACH;
+					} else {
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+		for (std::thread & t : threads) {
+			t.join();
+		}
+		long long n = PRODUCERS * EACH;
+		REQUIRE(taken == n);
+		REQUIRE(sum == n * (n - 1) / 2);
+		REQUIRE(ordered);
+		REQUIRE(m.isEmpty());
+	}
+}
+
+// Scaling with producers and consumers against a Queue behind a mutex - run with [benchmark]
+TEST_CASE("MpmcQueue Throughput", "[.][benchmark]")
+{
+	const int N = 1000000;
+
+	// producers share N elements between consumers, returns elements per second
+	auto run = [](int producers, int consumers, const std::function<bool(int)> & put, const std::function<bool(int &)> & take) {
+		std::atomic<int> taken(0);
+		std::vector<std::thread> threads;
+		auto start = std::chrono::steady_clock::now();
+		for (int p = 0; p < producers; p++) {
+			threads.emplace_back([&put, producers, p]() {
+				for (int i = p; i < N; i += producers) {
+					while (!put(i)) { std::this_thread::yield(); }
+				}
+			});
+		}
+		for (int c = 0; c < consumers; c++) {
+			threads.emplace_back([&take, &taken]() {
+				int v;
+				while (taken.load(std::memory_order_relaxed) < N) {
+					if (take(v)) { taken++; } else { std::this_thread::yield(); }
+				}
+			});
+		}
+		for (std::thread & t : threads) {
+			t.join();
+		}
+		std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+		return N / secs.count();
+	};
+
+	Queue<int> locked(1024);
+	std::mutex lock;
+	auto lockedPut = [&](int v) { std::lock_guard<std::mutex> hold(lock); if (locked.size() == locked.capacity()) { return false; } locked.enqueue(v); return true; };
+	auto lockedTake = [&](int & v) { std::lock_guard<std::mutex> hold(lock); if (locked.isEmpty()) { return false; } v = locked.peek(); locked.dequeue(); return true; };
+	MpmcQueue<int> mpmc(1024);
+	auto put = [&](int v) { return mpmc.tryEnqueue(v); };
+	auto take = [&](int & v) { return mpmc.tryDequeue(v); };
+
+	for (int producers = 1; producers <= 4; producers *= 2) {
+		for (int consumers = 1; consumers <= 4; consumers *= 2) {
+			double m = run(producers, consumers, lockedPut, lockedTake);
+			double f = run(producers, consumers, put, take);
+			std::cout << producers << "P/" << consumers << "C: mutex Queue " << (long)m << " /s, MpmcQueue "
+				<< (long)f << " /s" << std::endl;
+		}
+	}
+	REQUIRE(mpmc.isEmpty());
+}
+
+TEST_CASE("BlockingQueue Axioms", "[BlockingQueue]")
+{
+	BlockingQueue<std::string> q(4, 1);
+	const std::chrono::milliseconds brief(5);
+
+	SECTION("Test Put Take And Timeouts")
+	{
+		REQUIRE(q.put("apple"));
+		REQUIRE(q.put("orange", brief));
+		REQUIRE(q.size() == 2);
+		std::string s;
+		REQUIRE(q.take(s));
+		REQUIRE(s == "apple");
+		REQUIRE(q.take(s, brief));
+		REQUIRE(s == "orange");
+		REQUIRE_FALSE(q.take(s, brief));
+		REQUIRE(q.isEmpty());
+		REQUIRE_THROWS_AS(BlockingQueue<int>(4, 4), std::invalid_argument);
+	}
+
+	SECTION("Test Watermarks Hold Producers Until Low")
+	{
+		for (int i = 0; i < 4; i++) {
+			REQUIRE(q.put(std::to_string(i), brief));
+		}
+		REQUIRE_FALSE(q.put("high", brief));
+		std::string s;
+		q.take(s);
+		q.take(s);
+		REQUIRE(q.size() == 2);
+		REQUIRE_FALSE(q.put("above low", brief));	// still held back
+		q.take(s);
+		REQUIRE(q.put("at low", brief));
+		REQUIRE(q.size() == 2);
+	}
+
+	SECTION("Test Drain To ArrayList")
+	{
+		for (int i = 0; i < 4; i++) {
+			q.put(std::to_string(i));
+		}
+		ArrayList<std::string> out;
+		out.add("x");
+		REQUIRE(q.drainTo(out, 3) == 3);
+		REQUIRE(out.size() == 4);
+		REQUIRE(out.get(1) == "0");
+		REQUIRE(out.get(3) == "2");
+		REQUIRE(q.put("4", brief));					// drained below low
+		REQUIRE(q.drainTo(out, 10) == 2);
+		REQUIRE(out.get(5) == "4");
+		REQUIRE(q.drainTo(out, 10) == 0);
+	}
+
+	SECTION("Test Close Wakes Waiters And Lets Consumers Finish")
+	{
+		BlockingQueue<int> b(8);
+		std::atomic<int> sum(0);
+		std::vector<std::thread> consumers;
+		for (int c = 0; c < 2; c++) {
+			consumers.emplace_back([&b, &sum]() {
+				int v;
+				while (b.take(v)) {
+					sum += v;
+				}
+			});
+		}
+		for (int i = 1; i <= 1000; i++) {
+			REQUIRE(b.put(i));
+		}
+		b.close();
+		for (std::thread & t : consumers) {
+			t.join();
+		}
+		REQUIRE(sum == 500500);
+		REQUIRE(b.isClosed());
+		REQUIRE_FALSE(b.put(1));
+		int v;
+		REQUIRE_FALSE(b.take(v));
+	}
+}
+
+// Items taken one at a time against drainTo batches - run with [benchmark]
+TEST_CASE("BlockingQueue Throughput", "[.][benchmark]")
+{
+	const int N = 1000000, PRODUCERS = 2;
+
+	// PRODUCERS put N elements for one consumer, returns elements per second
+	auto run = [](int batch) {
+		BlockingQueue<int> q(4096, 1024);
+		std::vector<std::thread> producers;
+		auto start = std::chrono::steady_clock::now();
+		for (int p = 0; p < PRODUCERS; p++) {
+			producers.emplace_back([&q]() {
+				for (int i = 0; i < N / PRODUCERS; i++) {
+					q.put(i);
+				}
+			});
+		}
+		ArrayList<int> out(batch);
+		int v;
+		for (int got = 0; got < N; ) {
+			if (batch == 1) {
+				q.take(v);
+				got++;
+			} else {
+				out.clear();
+				int n = q.drainTo(out, batch);
+				if (n == 0) {
+					q.take(v);					// wait for more
+					n = 1;
+				}
+				got += n;
+			}
+		}
+		for (std::thread & t : producers) {
+			t.join();
+		}
+		std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+		return N / secs.count();
+	};
+
+	for (int batch = 1; batch <= 1024; batch *= 32) {
+		std::cout << "BlockingQueue consumer batch " << batch << ": " << (long)run(batch) << " /s" << std::endl;
+	}
+	REQUIRE(true);
+}
+
+TEST_CASE("ConcurrentStack Axioms", "[ConcurrentStack]")
+{
+	ConcurrentStack<std::string> s;
+
+	SECTION("Test Push Then Pop In Reverse")
+	{
+		REQUIRE(alignof(ConcurrentStack<std::string>) == CACHE_LINE);
+		REQUIRE(s.isEmpty());
+		s.push("apple");
+		s.push("orange");
+		s.push("pear");
+		REQUIRE_FALSE(s.isEmpty());
+		std::string v;
+		REQUIRE(s.pop(v));
+		REQUIRE(v == "pear");
+		REQUIRE(s.pop(v));
+		REQUIRE(v == "orange");
+		s.push("plum");
+		REQUIRE(s.pop(v));
+		REQUIRE(v == "plum");
+		REQUIRE(s.pop(v));
+		REQUIRE(v == "apple");
+		REQUIRE_FALSE(s.pop(v));
+		REQUIRE(s.isEmpty());
+	}
+
+	SECTION("Test Threads Push And Pop Every Element Once")
+	{
+		const int THREADS = 4, EACH = 20000;
+		for (int slots = 0; slots <= 4; slots += 4) {		// without and with elimination
+			ConcurrentStack<int> c(slots);
+			std::atomic<long long> sum(0);
+			std::atomic<int> popped(0);
+			std::vector<std::thread> threads;
+			for (int t = 0; t < THREADS; t++) {
+				threads.emplace_back([&c, &sum, &popped, t]() {
+					int v;
+					for (int i = 0; i < EACH; i++) {
+						c.push(t * EACH + i);
+						if (i % 2 == 1) {				// pop about as often as push
+							while (!c.pop(v)) {}
+							sum += v;
+							popped++;
+						}
+					}
+				});
+			}
+			for (std::thread & t : threads) {
+				t.join();
+			}
+			int v;
+			while (c.pop(v)) {
+				sum += v;
+				popped++;
+			}
+			long long n = THREADS * EACH;
+			REQUIRE(popped == n);
+			REQUIRE(sum == n * (n - 1) / 2);
+		}
+	}
+}
+
+// Push and pop pairs from 1 to 32 threads - run with [benchmark]
+TEST_CASE("ConcurrentStack Throughput", "[.][benchmark]")
+{
+	const int OPS = 400000;
+
+	// threads share OPS push then pop pairs, returns operations per second
+	auto run = [](int threads, const std::function<void(int)> & push, const std::function<bool(int &)> & pop) {
+		std::vector<std::thread> workers;
+		auto start = std::chrono::steady_clock::now();
+		for (int t = 0; t < threads; t++) {
+			workers.emplace_back([&push, &pop, threads]() {
+				int v;
+				for (int i = 0; i < OPS / threads; i++) {
+					push(i);
+					pop(v);
+				}
+			});
+		}
+		for (std::thread & w : workers) {
+			w.join();
+		}
+		std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+		return 2 * OPS / secs.count();
+	};
+
+	Stack<int> locked(64);
+	std::mutex lock;
+	ConcurrentStack<int> plain, eliminating(16);
+	for (int threads = 1; threads <= 32; threads *= 2) {
+		double m = run(threads,
+			[&](int v) { std::lock_guard<std::mutex> hold(lock); locked.push(v); },
+			[&](int & v) { std::lock_guard<std::mutex> hold(lock); if (locked.isEmpty()) { return false; } v = locked.top(); locked.pop(); return true; });
+		double p = run(threads, [&](int v) { plain.push(v); }, [&](int & v) { return plain.pop(v); });
+		double e = run(threads, [&](int v) { eliminating.push(v); }, [&](int & v) { return eliminating.pop(v); });
+		std::cout << threads << " threads: mutex Stack " << (long)m << " ops/s, ConcurrentStack " << (long)p
+			<< " ops/s, with elimination " << (long)e << " ops/s" << std::endl;
+	}
+	REQUIRE(plain.isEmpty());
+}
+
+TEST_CASE("PersistentVector Axioms", "[PersistentVector]")
+{
+	ArrayList<int> l(1000);
+	for (int i = 0; i < 1000; i++) {
+		l.add(i);
+	}
+	PersistentVector<int> v(l);
+
+	SECTION("Test Construction")
+	{
+		REQUIRE(v.size() == 1000);
+		REQUIRE(v.get(0) == 0);
+		REQUIRE(v.get(999) == 999);
+		REQUIRE(v.toArrayList() == l);
+		REQUIRE(PersistentVector<int>().isEmpty());
+		REQUIRE_THROWS_AS(v.get(1000), std::out_of_range);
+	}
+
+	SECTION("Test Set Leaves Original Unchanged")
+	{
+		PersistentVector<int> w = v.set(500, -1);
+		REQUIRE(w.get(500) == -1);
+		REQUIRE(v.get(500) == 500);
+		REQUIRE(w.size() == v.size());
+		REQUIRE(w != v);
+		REQUIRE(w.set(500, 500) == v);
+		REQUIRE(w.set(500, 500).set(999, 0) != v);
+	}
+
+	SECTION("Test Take Drop Mid")
+	{
+		REQUIRE(v.take(300).toArrayList() == ArrayList<int>(l.take(300)));
+		REQUIRE(v.drop(300).toArrayList() == ArrayList<int>(l.drop(300)));
+		REQUIRE(v.mid(123, 456).toArrayList() == ArrayList<int>(l.mid(123, 456)));
+		REQUIRE(v.take(0).isEmpty());
+		REQUIRE(v.drop(1000).isEmpty());
+		REQUIRE_THROWS_AS(v.take(1001), std::out_of_range);
+	}
+
+	SECTION("Test Concat And Reverse")
+	{
+		PersistentVector<int> w = v.drop(500).concat(v.take(500));
+		REQUIRE(w.size() == 1000);
+		REQUIRE(w.get(0) == 500);
+		REQUIRE(w.get(999) == 499);
+		REQUIRE(v.reverse().toArrayList() == ArrayList<int>(l.reverse()));
+		REQUIRE(v.concat(PersistentVector<int>()) == v);
+		REQUIRE(v.take(333).concat(v.drop(333)) == v);
+		REQUIRE(v.drop(1).add(0, 0) == v);
+		REQUIRE(v.drop(1).add(0, 1) != v);
+	}
+
+	SECTION("Test Add Remove")
+	{
+		PersistentVector<int> w = v.add(1000).add(0, -1).remove(500);
+		REQUIRE(w.size() == 1001);
+		REQUIRE(w.get(0) == -1);
+		REQUIRE(w.get(500) == 500);
+		REQUIRE(w.get(1000) == 1000);
+		REQUIRE(w.find(1000) == 1000);
+		REQUIRE(v.find(1000) == -1);
+	}
+
+	SECTION("Test Many Versions Stay Balanced")
+	{
+		PersistentVector<int> w;
+		for (int i = 0; i < 5000; i++) {
+			w = (i % 2 == 0) ? w.add(i) : w.add(0, i);
+		}
+		for (int i = 0; i < 200; i++) {
+			w = w.drop(7).concat(w.take(7));
+		}
+		REQUIRE(w.size() == 5000);
+		REQUIRE(w.height() <= 20);
+		ArrayList<int> a = w.toArrayList();
+		for (int i = 0; i < w.size(); i += 97) {
+			REQUIRE(w.get(i) == a.get(i));
+		}
+	}
+}
+
+TEST_CASE("Snapshot Axioms", "[Snapshot]")
+{
+	std::stringstream ss;
+
+	SECTION("Test Array Round Trip")
+	{
+		Array<int> a(1000);
+		for (int i = 0; i < a.length(); i++) { a[i] = i * i; }
+		saveSnapshot(a, ss);
+
+		Array<int> b;
+		loadSnapshot(b, ss);
+		REQUIRE(b.length() == 1000);
+		REQUIRE(b[999] == 999 * 999);
+	}
+
+	SECTION("Test ArrayList Of Strings Round Trip")
+	{
+		ArrayList<std::string> l;
+		l.add("apple"); l.add(""); l.add("orange");
+		saveSnapshot(l, ss);
+
+		ArrayList<std::string> m;
+		loadSnapshot(m, ss);
+		REQUIRE(m == l);
+	}
+
+	SECTION("Test BinaryTree Is Rebuilt Balanced")
+	{
+		BinaryTree<int> t;
+		for (int i = 0; i < 63; i++) { t.insert(i); }	// degenerate, height 63
+		saveSnapshot(t, ss);
+
+		BinaryTree<int> u;
+		loadSnapshot(u, ss);
+		REQUIRE(u.size() == 63);
+		REQUIRE(u.height() == 6);
+		REQUIRE(u.find(42) == true);
+	}
+
+	SECTION("Test HashTable Round Trip")
+	{
+		HashTable<int> h(13);
+		h.add("one", 1); h.add("two", 2); h.add("three", 3);
+		h.remove("two");
+		saveSnapshot(h, ss);
+
+		HashTable<int> k;
+		int v = 0;
+		loadSnapshot(k, ss);
+		REQUIRE(k.find("three", v) == true);
+		REQUIRE(v == 3);
+		REQUIRE(k.find("two", v) == false);
+	}
+
+	SECTION("Test Graph Round Trip")
+	{
+		Graph g(4, true);
+		g.addVertex("A"); g.addVertex("B"); g.addVertex("C");
+		g.addEdge("A", "B", 1); g.addEdge("B", "C", 1);
+		saveSnapshot(g, ss);
+
+		Graph h;
+		loadSnapshot(h, ss);
+		REQUIRE(h.isDirected() == true);
+		REQUIRE(h.stepsTo("A", "C", 2) == true);
+		REQUIRE(h.stepsTo("C", "A", 2) == false);
+		REQUIRE(h.dfs("A") == g.dfs("A"));
+	}
+
+	SECTION("Test Corrupt Snapshot Rejected And Target Unchanged")
+	{
+		Array<int> a(10);
+		a.initialise(5);
+		saveSnapshot(a, ss);
+		std::string bytes = ss.str();
+		bytes[bytes.length() - 1] ^= 1;		// flip a payload bit
+		std::stringstream bad(bytes);
+
+		Array<int> b(1);
+		b[0] = 9;
+		REQUIRE_THROWS_AS(loadSnapshot(b, bad), std::runtime_error);
+		REQUIRE(b[0] == 9);
+	}
+
+	SECTION("Test Corrupt Length Rejected Before Parsing")
+	{
+		Graph g(4, true);
+		g.addVertex("A");
+		saveSnapshot(g, ss);
+		std::string bytes = ss.str();
+		std::string resized = bytes;
+		resized[32] ^= 0x40;								// Graph size, after header and tag
+		std::stringstream flipped(resized);
+		std::uint64_t length = (std::uint64_t)1 << 40;
+		std::memcpy(&bytes[16], &length, sizeof(length));	// payload length in the header
+		std::stringstream longer(bytes);
+
+		Graph h;
+		REQUIRE_THROWS_AS(loadSnapshot(h, longer), std::runtime_error);
+		REQUIRE_THROWS_AS(loadSnapshot(h, flipped), std::runtime_error);
+	}
+
+	SECTION("Test Corrupt Graph Size Rejected Before Allocating")
+	{
+		SnapshotWriter w(ss);
+		w.writeTag("GRPH");
+		w.writeCount(1 << 30);
+		w.writeCount(0);
+		writeValue(w, false);
+		w.finish();
+
+		Graph h;
+		REQUIRE_THROWS_AS(loadSnapshot(h, ss), std::runtime_error);
+	}
+
+	SECTION("Test Corrupt HashTable Size Rejected")
+	{
+		SnapshotWriter w(ss);
+		w.writeTag("HTOP");
+		w.writeCount(0);
+		w.writeCount(0);
+		w.finish();
+		std::stringstream crowded;
+		SnapshotWriter c(crowded);
+		c.writeTag("HTOP");
+		c.writeCount(1);
+		c.writeCount(2);
+		for (int i = 0; i < 2; i++) {
+			writeValue(c, std::string("key") + std::to_string(i));
+			writeValue(c, i);
+		}
+		c.finish();
+
+		HashTable<int> h;
+		REQUIRE_THROWS_AS(loadSnapshot(h, ss), std::runtime_error);
+		REQUIRE_THROWS_AS(loadSnapshot(h, crowded), std::runtime_error);
+		int v = 0;
+		h.add("one", 1);
+		REQUIRE(h.find("one", v) == true);
+	}
+
+	SECTION("Test Wrong Container Rejected")
+	{
+		Array<int> a(3);
+		saveSnapshot(a, ss);
+		ArrayList<int> l;
+		REQUIRE_THROWS_AS(loadSnapshot(l, ss), std::runtime_error);
+	}
+}
+
 // ----------- Main method calls catch and menu ------------
 
 int main(int argc, char* argv[]) {
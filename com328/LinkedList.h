@@ -1,9 +1,13 @@
 /***********************************************************************
  * Name        : LinkedList.h
  * Author      : a.mccaughey@ulster.ac.uk
- * Version     : 1.3.2
+ * Version     : 1.7
  * Description : Advanced Head/Tail Dynamic Linked LinkedList class with
- *               exception handling and public Node and Iterator classes
+ *               exception handling and public Node and Iterator classes.
+ *               Positional operations start from the node last located
+ *               when it precedes the target, so a get(i) loop is O(n)
+ *               overall. As get updates that cursor, concurrent readers
+ *               of one list are not safe
  ***********************************************************************/
 
 #ifndef LINKEDLIST_H
@@ -12,6 +16,8 @@
 #include <cstdlib> // Defines NULL
 #include <iostream>
 #include <exception>
+#include <functional>
+#include "NodePool.h"
 
 // =============================== LIST NODE ==============================================
 // Node Class Used as Building Blocks of a LinkedList
@@ -30,6 +36,7 @@ template <class T>
 class ListIterator {
 	public:
 		ListIterator(Node<T> *start=NULL) : current(start)	{}
+		ListIterator(const ListIterator & o) = default;
 		ListIterator & operator=(const ListIterator & o)	{ current = o.current; return (*this); }
 		T & operator*()										{ return current->data; }
 		ListIterator & operator++()							{ current = current->next; return *(this);}
@@ -38,18 +45,20 @@ class ListIterator {
 		bool operator!=(const ListIterator & o)				{ return current != o.current; }
 		bool operator==(const ListIterator & o)				{ return current == o.current; }
 	private:
+		template <class, class> friend class LinkedList;
 		Node<T> *current;
 };
 
 // ============================== LINKED LinkedList ===========================================
-template <class T>
+// Nodes selects how nodes are allocated, see NodePool.h
+template <class T, class Nodes = NodePool< Node<T> > >
 class LinkedList {
 public:
     LinkedList();
     virtual ~LinkedList();
-    LinkedList(const LinkedList<T> & other);
-	void operator=(const LinkedList<T> & other);
-	bool operator==(const LinkedList<T> & other) const;
+    LinkedList(const LinkedList & other);
+	void operator=(const LinkedList & other);
+	bool operator==(const LinkedList & other) const;
 	
     void clear();
 	void add(const T & value);
@@ -69,47 +78,74 @@ public:
     ListIterator<T> begin() const	{ return ListIterator<T>(header->next); }
     ListIterator<T> end()   const	{ return ListIterator<T>(nullptr); }
 
+	// Iterator based editing - relinks nodes so elements are never copied. The After
+	// forms are O(1); the others first locate the preceding node, which is O(1) at
+	// begin() and end() and O(n) elsewhere
+	ListIterator<T> beforeBegin()	{ return ListIterator<T>(header); }
+	ListIterator<T> insertAfter(ListIterator<T> pos, const T & value);
+	ListIterator<T> insertBefore(ListIterator<T> pos, const T & value);
+	ListIterator<T> eraseAfter(ListIterator<T> pos);
+	ListIterator<T> erase(ListIterator<T> pos);
+	void spliceAfter(ListIterator<T> pos, LinkedList & other, ListIterator<T> beforeFirst, ListIterator<T> last);
+	void splice(ListIterator<T> pos, LinkedList & other, ListIterator<T> first, ListIterator<T> last);
+	void splice(ListIterator<T> pos, LinkedList & other);
+
+	// Stable sorting by relinking nodes - no allocation and no element copies
+	template <class Compare = std::less<T> >
+	void sort(Compare cmp = Compare());
+	template <class Compare = std::less<T> >
+	void merge(LinkedList & other, Compare cmp = Compare());
+
 private:
+	template <class Compare>
+	static Node<T>* mergeRuns(Node<T>* a, Node<T>* b, Compare & cmp);
 	Node<T>* nodeAt(int pos) const;
-	void deepCopy(const LinkedList<T> & c);
+	Node<T>* before(Node<T>* n) const;
+	void deepCopy(const LinkedList & c);
+	void resetCursor() const		{ cursor = header; cursorPos = -1; }
 
     Node<T> *header, *tail;
     int count;
+    Nodes nodes;
+	mutable Node<T> *cursor;	// node last located by nodeAt and its position,
+	mutable int cursorPos;		// header (-1) after edits that move nodes
 };
 
 // ============================== LinkedList Implementation ======================
 
 // Default Constructor
-template <class T>
-LinkedList<T>::LinkedList() {
+template <class T, class Nodes>
+LinkedList<T, Nodes>::LinkedList() {
 	header = new Node<T>();
 	tail = header;			// TAIL POINTS TO HEADER
 	count = 0;
+	resetCursor();
 }
 
-// Destructor
-template <class T>
-LinkedList<T>::~LinkedList() {
+// Destructor - O(n), clear releases the nodes in a single pass
+template <class T, class Nodes>
+LinkedList<T, Nodes>::~LinkedList() {
     clear();
 	delete header; // delete dummy header node
 }
 
 // PostCondition: construct LinkedList as a duplicate of c
-template <class T>
-LinkedList<T>::LinkedList(const LinkedList<T> & other) {
+template <class T, class Nodes>
+LinkedList<T, Nodes>::LinkedList(const LinkedList<T, Nodes> & other) {
 	header = new Node<T>;	// create dummy header
+	resetCursor();
     deepCopy(other);			// create a deep copy of other
 }
 
 // PreCondition: c refers to a LinkedLinkedList
 // PostCondition: perform a deep copy of c
-template <class T>
-void LinkedList<T>::deepCopy(const LinkedList<T> & c) {
+template <class T, class Nodes>
+void LinkedList<T, Nodes>::deepCopy(const LinkedList<T, Nodes> & c) {
 	Node<T>* cc = c.header->next;
     Node<T>* prev = header;
     Node<T>* n;			// new Node reference
     while (cc != NULL) {
-        n = new Node<T>(cc->data, prev->next);
+        n = nodes.create(cc->data, prev->next);
         prev->next = n;	// set last to refer to n
         prev = n;		// set last to n
         cc = cc->next;	// move to next Node in c
@@ -119,16 +155,47 @@ void LinkedList<T>::deepCopy(const LinkedList<T> & c) {
 }
 
 
-// PostCondition: assign c to LinkedList
-template<class T>
-void LinkedList<T>::operator=(const LinkedList<T> & other) {
-	clear();		// clear existing LinkedList
-	deepCopy(other);	// perform a deep copy
+// PostCondition: assign other to LinkedList in O(n), reusing existing nodes - values
+//                are copied into them, surplus nodes released or missing nodes added
+template <class T, class Nodes>
+void LinkedList<T, Nodes>::operator=(const LinkedList<T, Nodes> & other) {
+	if (this == &other) {
+		return;
+	}
+	if (other.isEmpty()) {
+		clear();
+		return;
+	}
+	Node<T>* prev = header;
+	Node<T>* src = other.header->next;
+	while (src != nullptr && prev->next != nullptr) {	// overwrite existing nodes
+		prev = prev->next;
+		prev->data = src->data;
+		src = src->next;
+	}
+	if (src != nullptr) {								// add nodes for the rest of other
+		while (src != nullptr) {
+			prev->next = nodes.create(src->data, nullptr);
+			prev = prev->next;
+			src = src->next;
+		}
+	} else {											// release nodes beyond other's length
+		Node<T>* n = prev->next;
+		prev->next = nullptr;
+		while (n != nullptr) {
+			Node<T>* d = n;
+			n = n->next;
+			nodes.destroy(d);
+		}
+	}
+	tail = prev;		// SET TAIL TO LAST NODE
+	count = other.count;
+	resetCursor();
 }
 
 // PostCondition: test LinkedLists for equality
-template<class T>
-bool LinkedList<T>::operator==(const LinkedList<T> & other) const {
+template <class T, class Nodes>
+bool LinkedList<T, Nodes>::operator==(const LinkedList<T, Nodes> & other) const {
 	bool same=true;
 	if (size() != other.size()) {
 		same = false;
@@ -150,37 +217,37 @@ bool LinkedList<T>::operator==(const LinkedList<T> & other) const {
 }
 
 // PostCondition: return number of elements in LinkedList
-template<class T>
-int LinkedList<T>::size() const {
+template <class T, class Nodes>
+int LinkedList<T, Nodes>::size() const {
     return count;
 }
 
 
 // PreCondition: pos is a valid insertion LinkedList position
 // PostCondition: inserts element value at specified position in linked LinkedList
-template<class T>
-void LinkedList<T>::add(int pos, const T & value) {
+template <class T, class Nodes>
+void LinkedList<T, Nodes>::add(int pos, const T & value) {
 	if (pos < 0 || pos > size()) {
 		throw std::out_of_range("LinkedList invalid position: " + std::to_string(pos));
 	}
  	Node<T>* prev = nodeAt(pos - 1);
-	Node<T>* n = new Node<T> (value, prev->next);
+	Node<T>* n = nodes.create(value, prev->next);
 	prev->next = n;
 	if (pos == count) {tail = n;}           // INSERTED AT END SO UPDATE TAIL
 	count++;	
 }
 
 // PostCondition: inserts element value at end of linked LinkedList
-template<class T>
-void LinkedList<T>::add(const T & value) {
+template <class T, class Nodes>
+void LinkedList<T, Nodes>::add(const T & value) {
 	add(size(),value);
 }
 
 
 // PreCondition: pos is a valid LinkedList position
 // PostCondition: deletes Node at specified position in linked LinkedList
-template<class T>
-void LinkedList<T>::remove(int pos) {
+template <class T, class Nodes>
+void LinkedList<T, Nodes>::remove(int pos) {
 	if (pos < 0 || pos >= size()) {
 		throw std::out_of_range("LinkedList invalid position: " + std::to_string(pos));
 	}
@@ -189,13 +256,13 @@ void LinkedList<T>::remove(int pos) {
 	prev->next = curr->next;				// set prev to refer to next node
 	if (pos == count - 1) { tail = prev; }	// IF LAST NODE DELETED UPDATE TAIL
 	count--;								// reduce number of elements in LinkedList
-	delete curr;							// delete Node referred to by curr
+	nodes.destroy(curr);					// release Node referred to by curr
 }
 
 // PreCondition: pos is a valid LinkedList position
 // PostCondition: deletes Node at specified position in linked LinkedList
-template<class T>
-T LinkedList<T>::get(int pos) const  {
+template <class T, class Nodes>
+T LinkedList<T, Nodes>::get(int pos) const  {
 	if (pos < 0 || pos >= size()) {
 		throw std::out_of_range("LinkedList invalid position: " + std::to_string(pos));
 	}
@@ -206,8 +273,8 @@ T LinkedList<T>::get(int pos) const  {
 
 // PreCondition: pos is a valid LinkedList position
 // PostCondition: updates value part of Node at specified position in linked LinkedList
-template<class T>
-void LinkedList<T>::set(int pos, const T & value) {
+template <class T, class Nodes>
+void LinkedList<T, Nodes>::set(int pos, const T & value) {
 	if (pos < 0 || pos >= size()) {
 		throw std::out_of_range("LinkedList invalid position: " + std::to_string(pos));
 	}
@@ -216,8 +283,8 @@ void LinkedList<T>::set(int pos, const T & value) {
 }
 
 // PostCondition: returns index of LinkedList item if found or -1 if not found
-template<class T>
-int LinkedList<T>::find(const T & value) const {
+template <class T, class Nodes>
+int LinkedList<T, Nodes>::find(const T & value) const {
     /* Using LinkedList node traversal - efficent
 	Node<T>* tmp = header->next;
     for (int p = 0; (tmp != NULL); p++) {
@@ -248,8 +315,8 @@ int LinkedList<T>::find(const T & value) const {
 }
 
 // PostCondition: prints contents of LinkedList to standard output
-template<class T>
-void LinkedList<T>::print(std::ostream & os) const {
+template <class T, class Nodes>
+void LinkedList<T, Nodes>::print(std::ostream & os) const {
 
     ListIterator<T> itr = begin();
 	os <<  "[ ";
@@ -260,40 +327,277 @@ void LinkedList<T>::print(std::ostream & os) const {
     os << "]";
 }
 
-// PreCondition:  pos is valid 
-// PostCondition: returns reference to Node at specified position
-template<class T>
-Node<T>* LinkedList<T>::nodeAt(int pos) const {   
+// PreCondition: pos refers to a node of this list or beforeBegin()
+// PostCondition: value inserted after pos, returns iterator to it
+template <class T, class Nodes>
+ListIterator<T> LinkedList<T, Nodes>::insertAfter(ListIterator<T> pos, const T & value) {
+	Node<T>* p = pos.current;
+	if (p == nullptr) {
+		throw std::out_of_range("LinkedList invalid iterator: end()");
+	}
+	Node<T>* n = nodes.create(value, p->next);
+	p->next = n;
+	if (p == tail) { tail = n; }		// INSERTED AT END SO UPDATE TAIL
+	count++;
+	resetCursor();
+	return ListIterator<T>(n);
+}
+
+// PreCondition: pos refers to a node of this list or end()
+// PostCondition: value inserted before pos, returns iterator to it
+template <class T, class Nodes>
+ListIterator<T> LinkedList<T, Nodes>::insertBefore(ListIterator<T> pos, const T & value) {
+	return insertAfter(ListIterator<T>(before(pos.current)), value);
+}
+
+// PreCondition: pos refers to a node of this list, or beforeBegin(), with a successor
+// PostCondition: successor of pos removed, returns iterator to the node that followed it
+template <class T, class Nodes>
+ListIterator<T> LinkedList<T, Nodes>::eraseAfter(ListIterator<T> pos) {
+	Node<T>* p = pos.current;
+	if (p == nullptr || p->next == nullptr) {
+		throw std::out_of_range("LinkedList invalid iterator: nothing to erase");
+	}
+	Node<T>* d = p->next;
+	p->next = d->next;
+	if (d == tail) { tail = p; }		// IF LAST NODE DELETED UPDATE TAIL
+	count--;
+	resetCursor();
+	nodes.destroy(d);
+	return ListIterator<T>(p->next);
+}
+
+// PreCondition: pos refers to a node of this list
+// PostCondition: node at pos removed, returns iterator to the node that followed it
+template <class T, class Nodes>
+ListIterator<T> LinkedList<T, Nodes>::erase(ListIterator<T> pos) {
+	if (pos.current == nullptr) {
+		throw std::out_of_range("LinkedList invalid iterator: end()");
+	}
+	return eraseAfter(ListIterator<T>(before(pos.current)));
+}
+
+// PreCondition: pos refers to a node of this list or beforeBegin(), (beforeFirst, last)
+//               is a range of other and pos is not in (beforeFirst, last), though it may
+//               be the last node of the range, which leaves the list unchanged
+// PostCondition: nodes after beforeFirst up to but excluding last moved from other to
+//                follow pos. O(k) for k nodes moved, as they are counted
+template <class T, class Nodes>
+void LinkedList<T, Nodes>::spliceAfter(ListIterator<T> pos, LinkedList<T, Nodes> & other, ListIterator<T> beforeFirst, ListIterator<T> last) {
+	Node<T>* p = pos.current;
+	Node<T>* b = beforeFirst.current;
+	if (p == nullptr || b == nullptr) {
+		throw std::out_of_range("LinkedList invalid iterator: end()");
+	}
+	Node<T>* first = b->next;
+	if (first == last.current) {
+		return;
+	}
+	Node<T>* end = first;		// last node moved
+	int k = 1;
+	while (end->next != last.current) {
+		end = end->next;
+		k++;
+	}
+	if (p == end) {
+		return;					// range already follows pos
+	}
+
+	b->next = last.current;		// unlink from other
+	if (other.tail == end) { other.tail = b; }
+
+	end->next = p->next;		// link after pos
+	p->next = first;
+	if (tail == p) { tail = end; }
+	resetCursor();
+	other.resetCursor();
+
+	if (&other != this) {
+		other.count -= k;
+		count += k;
+		nodes.merge(other.nodes);	// nodes of other are now released by this list
+	}
+}
+
+// PreCondition: pos refers to a node of this list or end(), [first, last) is a range
+//               of other and pos is not in (first, last). pos == last (or first) leaves
+//               the list unchanged, as std::list does
+// PostCondition: nodes first up to but excluding last moved from other to before pos
+template <class T, class Nodes>
+void LinkedList<T, Nodes>::splice(ListIterator<T> pos, LinkedList<T, Nodes> & other, ListIterator<T> first, ListIterator<T> last) {
+	Node<T>* p = before(pos.current);
+	Node<T>* b = other.before(first.current);
+	spliceAfter(ListIterator<T>(p), other, ListIterator<T>(b), last);
+}
+
+// PreCondition: other is not this list
+// PostCondition: all nodes of other moved to before pos in O(1) (O(n) for pos other
+//                than begin() or end()), other is empty
+template <class T, class Nodes>
+void LinkedList<T, Nodes>::splice(ListIterator<T> pos, LinkedList<T, Nodes> & other) {
+	if (&other == this || other.isEmpty()) {
+		return;
+	}
+	Node<T>* p = before(pos.current);
+	other.tail->next = p->next;
+	p->next = other.header->next;
+	if (p == tail) { tail = other.tail; }
+	count += other.count;
+	nodes.merge(other.nodes);
+	resetCursor();
+
+	other.header->next = nullptr;
+	other.tail = other.header;
+	other.count = 0;
+	other.resetCursor();
+}
+
+// PostCondition: list sorted into the order given by cmp in O(n log n) - bottom up merge
+//                sort, keeping runs of 1, 2, 4 ... nodes in bins as a binary counter.
+//                Stable, equal elements keep their order
+template <class T, class Nodes>
+template <class Compare>
+void LinkedList<T, Nodes>::sort(Compare cmp) {
+	if (count < 2) {
+		return;
+	}
+	Node<T>* bins[32] = {};		// bins[i] empty or a sorted run of 2^i nodes
+	Node<T>* n = header->next;
+	while (n != nullptr) {
+		Node<T>* run = n;
+		n = n->next;
+		run->next = nullptr;
+		int i = 0;
+		for (; bins[i] != nullptr; i++) {	// earlier nodes are in bins[i], so it goes first
+			run = mergeRuns(bins[i], run, cmp);
+			bins[i] = nullptr;
+		}
+		bins[i] = run;
+	}
+	Node<T>* sorted = nullptr;
+	for (int i = 0; i < 32; i++) {			// higher bins hold the earlier nodes
+		if (bins[i] != nullptr) {
+			sorted = mergeRuns(bins[i], sorted, cmp);
+		}
+	}
+	header->next = sorted;
+	for (tail = sorted; tail->next != nullptr; tail = tail->next) {}
+	resetCursor();
+}
+
+// PreCondition: this list and other are both sorted by cmp
+// PostCondition: nodes of other merged into this list in one pass, keeping it sorted,
+//                other is empty. On equal elements those of this list come first
+template <class T, class Nodes>
+template <class Compare>
+void LinkedList<T, Nodes>::merge(LinkedList<T, Nodes> & other, Compare cmp) {
+	if (&other == this || other.isEmpty()) {
+		return;
+	}
+	if (isEmpty() || !cmp(other.tail->data, tail->data)) {
+		tail = other.tail;
+	}
+	header->next = mergeRuns(header->next, other.header->next, cmp);
+	count += other.count;
+	nodes.merge(other.nodes);
+	resetCursor();
+
+	other.header->next = nullptr;
+	other.tail = other.header;
+	other.count = 0;
+	other.resetCursor();
+}
+
+// PreCondition: a and b are null terminated runs sorted by cmp
+// PostCondition: returns the two runs merged into one, nodes of a first on equal elements
+template <class T, class Nodes>
+template <class Compare>
+Node<T>* LinkedList<T, Nodes>::mergeRuns(Node<T>* a, Node<T>* b, Compare & cmp) {
+	Node<T>* merged;
+	Node<T>** link = &merged;		// where the next node taken is linked
+	while (a != nullptr && b != nullptr) {
+		if (cmp(b->data, a->data)) {
+			*link = b;
+			b = b->next;
+		} else {
+			*link = a;
+			a = a->next;
+		}
+		link = &(*link)->next;
+	}
+	*link = (a != nullptr) ? a : b;
+	return merged;
+}
+
+// PreCondition: n is a node of this list or nullptr (end)
+// PostCondition: returns node preceding n - header when n is first, tail when n is nullptr
+template <class T, class Nodes>
+Node<T>* LinkedList<T, Nodes>::before(Node<T>* n) const {
+	if (n == nullptr) {
+		return tail;
+	}
+	Node<T>* p = header;
+	while (p->next != n) {
+		if (p->next == nullptr) {
+			throw std::out_of_range("LinkedList invalid iterator: not in list");
+		}
+		p = p->next;
+	}
+	return p;
+}
+
+// PreCondition:  pos is valid, -1 for the header
+// PostCondition: returns reference to Node at specified position, walking on from the
+//                cursor when it is not beyond pos, and leaves the cursor there
+template <class T, class Nodes>
+Node<T>* LinkedList<T, Nodes>::nodeAt(int pos) const {   
 	if (pos == count-1) {	// LAST NODE SO RETURN tail
 		return tail;
 	} else {				// Locate node
 		Node<T>* p = header;
-	    for (int i = 0; i <= pos; i++) {
+		int i = -1;
+		if (cursorPos <= pos) {
+			p = cursor;
+			i = cursorPos;
+		}
+	    for (; i < pos; i++) {
 		    p = p->next;
 		}
+		cursor = p;
+		cursorPos = pos;
 		return p;
 	}
 }
 
-// PostCondition: LinkedList is emptied count == 0;
-template<class T>
-void LinkedList<T>::clear() {
-	for (int i = size() - 1; i >= 0; i--) {
-		remove(i);
+// PostCondition: LinkedList is emptied count == 0; all nodes are released together
+template <class T, class Nodes>
+void LinkedList<T, Nodes>::clear() {
+	if (!nodes.discardIsTrivial()) {
+		Node<T>* n = header->next;
+		while (n != nullptr) {
+			Node<T>* d = n;
+			n = n->next;
+			nodes.discard(d);
+		}
 	}
+	nodes.reset();
+	header->next = nullptr;
+	tail = header;
+	count = 0;
+	resetCursor();
 }
 
 //PostCondition: returns countgth of LinkedList
-template<class T>
-bool LinkedList<T>::isEmpty() const {
+template <class T, class Nodes>
+bool LinkedList<T, Nodes>::isEmpty() const {
     return (count == 0);
 }
 
 
 // PreCondition: None
 // PostCondition: overload << operator to output LinkedList on ostream
-template <class T>
-std::ostream& operator <<(std::ostream& output, const LinkedList<T>& l) {
+template <class T, class Nodes>
+std::ostream& operator <<(std::ostream& output, const LinkedList<T, Nodes>& l) {
     l.print(output);
     return output;  // for multiple << operators.
 }
@@ -5,7 +5,7 @@
  *
  * @author  Aiden McCaughey
  * @email   a.mccaughey@ulster.ac.uk
- * @version 1.0
+ * @version 1.1
  *
  */
 
@@ -13,6 +13,7 @@
 #define Collection_H
 
 #include "ArrayList.h"
+#include <algorithm>
 
 template <class T>
 class Collection
@@ -62,12 +63,11 @@ void Collection<T>::add(const T & e)
 template <class T>
 bool Collection<T>::remove(const T & e)
 {
-    for(int i=0; i<used; i++) {
-        if (items.get(i) == e) {
-            items.remove(i);
-            used--;
-            return true;
-        }
+    int pos = items.find(e);
+    if (pos >= 0) {
+        items.remove(pos);
+        used--;
+        return true;
     }
     return false;
 }
@@ -80,12 +80,7 @@ bool Collection<T>::remove(const T & e)
 template <class T>
 bool Collection<T>::find(const T & e) const
 {
-    for(int i=0; i<used; i++) {
-        if (items.get(i) == e) {
-            return true;
-        }
-    }
-    return false;
+    return items.find(e) >= 0;
 }
 
 /**
@@ -105,11 +100,7 @@ int Collection<T>::count() const
 template <class T>
 int Collection<T>::count(const T & e) const
 {
-    int count = 0;
-    for(int i=0; i<used; i++) {
-        if (items.get(i) == e) count++;
-    }
-    return count;
+    return (int)std::count(items.begin(), items.end(), e);
 }
 
 /**
@@ -131,8 +122,8 @@ template <class T>
 void Collection<T>::print(std::ostream & out ) const
 {
 	out << "( ";
-	for(int i=0; i<used; i++)
-		out << items.get(i) << " ";
+	for (const T & e : items)
+		out << e << " ";
 	out << ")";
 }
 
@@ -144,8 +135,8 @@ bool Collection<T>::operator==(const Collection<T> & other) const
     if (count() != other.count()) {
         same = false;
     }
-    for(int i=0; same && i<count(); i++) {
-        if (count(items.get(i)) != other.count(items.get(i))) {
+    for (auto e = items.begin(); same && e != items.end(); ++e) {
+        if (count(*e) != other.count(*e)) {
             same = false;
         }
     } 
@@ -0,0 +1,266 @@
+/**
+ * ListView.h
+ *
+ * Lazy query pipeline over an ArrayList, e.g.
+ *
+ *   list.view().filter(p).map(f).drop(n).take(k).collect()
+ *
+ * Each call adds a stage to the view without touching the elements. When
+ * the view is collected (or counted, or visited with forEach) each element
+ * is pushed through all the stages in a single pass, with no intermediate
+ * lists, and the pass stops as soon as a take(k) stage is satisfied.
+ *
+ * reverse() of the list itself is free. Reversing a view after filter, map,
+ * drop or take has to hold the elements reaching it, so it buffers them.
+ *
+ * A view refers to the elements of the list it was created from, so it is
+ * only valid while that list is alive and unchanged.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.0
+ */
+
+#ifndef LISTVIEW_H_
+#define LISTVIEW_H_
+
+#include <type_traits>
+#include <utility>
+#include "ArraySpan.h"
+#include "ArrayList.h"
+
+// ============================ STAGES =====================================================
+// A stage has a value_type and run(sink), which pushes each of its values to
+// sink in turn until sink returns false
+
+// Elements of a list, first to last
+template <class T>
+class SpanSource {
+public:
+	typedef T value_type;
+
+	explicit SpanSource(ArraySpan<const T> elements) : elements(elements) {}
+
+	template <class Sink>
+	void run(Sink & sink) const {
+		for (int i = 0; i < elements.length(); i++) {
+			if (!sink(elements.unchecked_at(i))) {
+				return;
+			}
+		}
+	}
+
+	ArraySpan<const T> span() const { return elements; }
+
+private:
+	ArraySpan<const T> elements;
+};
+
+// Values of Source for which pred is true
+template <class Source, class Pred>
+class FilterStage {
+public:
+	typedef typename Source::value_type value_type;
+
+	FilterStage(const Source & source, Pred pred) : source(source), pred(pred) {}
+
+	template <class Sink>
+	void run(Sink & sink) const {
+		auto stage = [&](const value_type & v) { return pred(v) ? sink(v) : true; };
+		source.run(stage);
+	}
+
+private:
+	Source source;
+	Pred   pred;
+};
+
+// f applied to each value of Source
+template <class Source, class F>
+class MapStage {
+public:
+	typedef typename std::decay<decltype(std::declval<const F&>()(std::declval<const typename Source::value_type&>()))>::type value_type;
+
+	MapStage(const Source & source, F f) : source(source), f(f) {}
+
+	template <class Sink>
+	void run(Sink & sink) const {
+		auto stage = [&](const typename Source::value_type & v) { return sink(f(v)); };
+		source.run(stage);
+	}
+
+private:
+	Source source;
+	F      f;
+};
+
+// All but the first n values of Source
+template <class Source>
+class DropStage {
+public:
+	typedef typename Source::value_type value_type;
+
+	DropStage(const Source & source, int n) : source(source), n(n) {}
+
+	template <class Sink>
+	void run(Sink & sink) const {
+		int skipped = 0;
+		auto stage = [&](const value_type & v) { return (skipped < n) ? (++skipped, true) : sink(v); };
+		source.run(stage);
+	}
+
+private:
+	Source source;
+	int    n;
+};
+
+// First n values of Source - Source stops as soon as n values have passed
+template <class Source>
+class TakeStage {
+public:
+	typedef typename Source::value_type value_type;
+
+	TakeStage(const Source & source, int n) : source(source), n(n) {}
+
+	template <class Sink>
+	void run(Sink & sink) const {
+		int taken = 0;
+		auto stage = [&](const value_type & v) { return sink(v) && ++taken < n; };
+		if (n > 0) {
+			source.run(stage);
+		}
+	}
+
+private:
+	Source source;
+	int    n;
+};
+
+// Values of Source last to first, buffered as they have to be produced first to last
+template <class Source>
+class ReverseStage {
+public:
+	typedef typename Source::value_type value_type;
+
+	explicit ReverseStage(const Source & source) : source(source) {}
+
+	template <class Sink>
+	void run(Sink & sink) const {
+		ArrayList<value_type> buffer;
+		auto stage = [&](const value_type & v) { buffer.add(v); return true; };
+		source.run(stage);
+		for (int i = buffer.size() - 1; i >= 0 && sink(buffer.get(i)); i--) {}
+	}
+
+private:
+	Source source;
+};
+
+// Elements of a list last to first - no buffer is needed
+template <class T>
+class ReverseStage< SpanSource<T> > {
+public:
+	typedef T value_type;
+
+	explicit ReverseStage(const SpanSource<T> & source) : elements(source.span().reverse()) {}
+
+	template <class Sink>
+	void run(Sink & sink) const {
+		for (int i = 0; i < elements.length(); i++) {
+			if (!sink(elements.unchecked_at(i))) {
+				return;
+			}
+		}
+	}
+
+private:
+	ReverseSpan<const T> elements;
+};
+
+// ============================ VIEW =======================================================
+
+template <class Source>
+class ListView {
+public:
+	typedef typename Source::value_type value_type;
+
+	explicit ListView(const Source & source) : source(source) {}
+
+	template <class Pred>
+	ListView< FilterStage<Source, Pred> > filter(Pred pred) const;
+	template <class F>
+	ListView< MapStage<Source, F> >       map(F f) const;
+	ListView< DropStage<Source> >         drop(int n) const;
+	ListView< TakeStage<Source> >         take(int n) const;
+	ListView< ReverseStage<Source> >      reverse() const;
+
+	ArrayList<value_type> collect() const;
+	int count() const;
+	template <class Action>
+	void forEach(Action action) const;
+
+private:
+	Source source;
+};
+
+// ========================= IMPLEMENTATION ListView.cpp ===================================
+
+// PostCondition: view of the values for which pred is true
+template <class Source>
+template <class Pred>
+ListView< FilterStage<Source, Pred> > ListView<Source>::filter(Pred pred) const {
+	return ListView< FilterStage<Source, Pred> >(FilterStage<Source, Pred>(source, pred));
+}
+
+// PostCondition: view of f applied to each value
+template <class Source>
+template <class F>
+ListView< MapStage<Source, F> > ListView<Source>::map(F f) const {
+	return ListView< MapStage<Source, F> >(MapStage<Source, F>(source, f));
+}
+
+// PostCondition: view of all but the first n values (all values when n <= 0)
+template <class Source>
+ListView< DropStage<Source> > ListView<Source>::drop(int n) const {
+	return ListView< DropStage<Source> >(DropStage<Source>(source, n));
+}
+
+// PostCondition: view of at most the first n values
+template <class Source>
+ListView< TakeStage<Source> > ListView<Source>::take(int n) const {
+	return ListView< TakeStage<Source> >(TakeStage<Source>(source, n));
+}
+
+// PostCondition: view of the values last to first
+template <class Source>
+ListView< ReverseStage<Source> > ListView<Source>::reverse() const {
+	return ListView< ReverseStage<Source> >(ReverseStage<Source>(source));
+}
+
+// PostCondition: returns a new list of the values, produced in a single pass
+template <class Source>
+ArrayList<typename ListView<Source>::value_type> ListView<Source>::collect() const {
+	ArrayList<value_type> result;
+	auto sink = [&](const value_type & v) { result.add(v); return true; };
+	source.run(sink);
+	return result;
+}
+
+// PostCondition: returns number of values, produced in a single pass
+template <class Source>
+int ListView<Source>::count() const {
+	int n = 0;
+	auto sink = [&](const value_type &) { n++; return true; };
+	source.run(sink);
+	return n;
+}
+
+// PostCondition: action called with each value in a single pass
+template <class Source>
+template <class Action>
+void ListView<Source>::forEach(Action action) const {
+	auto sink = [&](const value_type & v) { action(v); return true; };
+	source.run(sink);
+}
+
+#endif
@@ -0,0 +1,220 @@
+/**
+ * MappedArray.h
+ *
+ * Generic Dynamic Array backed by a memory mapped binary file of fixed
+ * width T records. Opening a file is O(1), pages are read on demand as
+ * elements are accessed, so files larger than RAM can be searched and
+ * sorted without first being parsed into memory.
+ *
+ * Modes
+ *   MAP_READ_ONLY      - elements may only be read. The file is mapped as a
+ *                        MappedArray<const T>, an ArraySpan<const T>, so the
+ *                        searches accept it and writes do not compile
+ *   MAP_COPY_ON_WRITE  - elements may be modified, changes are private to
+ *                        this process and never written back to the file.
+ *                        A MappedArray<T> is an Array and maps in this mode
+ *
+ * Growing beyond the mapped records moves the elements to the heap.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.1
+ */
+
+#ifndef MAPPEDARRAY_H_
+#define MAPPEDARRAY_H_
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "Array.h"
+#include "ArraySpan.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+enum MapMode { MAP_READ_ONLY, MAP_COPY_ON_WRITE };
+
+// Mapping of a whole file. Held as a base class of MappedArray so that the
+// file is mapped before, and unmapped after, the Array base class uses it.
+struct FileMapping {
+	void  *address;
+	size_t bytes;
+#if defined(_WIN32)
+	HANDLE file;
+	HANDLE mapping;
+#endif
+
+	// PostCondition: file fname is mapped in the specified mode, throws
+	//                runtime_error if the file cannot be opened or mapped
+	FileMapping(const std::string & fname, MapMode mode) : address(nullptr), bytes(0)
+	{
+#if defined(_WIN32)
+		mapping = NULL;
+		file = CreateFileA(fname.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+		                   FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE) {
+			throw std::runtime_error("MappedArray: cannot open " + fname);
+		}
+		LARGE_INTEGER size;
+		GetFileSizeEx(file, &size);
+		bytes = (size_t)size.QuadPart;
+		if (bytes > 0) {
+			mapping = CreateFileMappingA(file, NULL, (mode == MAP_READ_ONLY) ? PAGE_READONLY : PAGE_WRITECOPY, 0, 0, NULL);
+			if (mapping != NULL) {
+				address = MapViewOfFile(mapping, (mode == MAP_READ_ONLY) ? FILE_MAP_READ : FILE_MAP_COPY, 0, 0, 0);
+			}
+			if (address == nullptr) {
+				unmap();
+				throw std::runtime_error("MappedArray: cannot map " + fname);
+			}
+		}
+#else
+		int fd = ::open(fname.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw std::runtime_error("MappedArray: cannot open " + fname);
+		}
+		struct stat info;
+		if (::fstat(fd, &info) == 0) {
+			bytes = (size_t)info.st_size;
+		}
+		if (bytes > 0) {
+			int protection = (mode == MAP_READ_ONLY) ? PROT_READ : PROT_READ | PROT_WRITE;
+			void *p = ::mmap(nullptr, bytes, protection, MAP_PRIVATE, fd, 0);
+			address = (p == MAP_FAILED) ? nullptr : p;
+		}
+		::close(fd);	// the mapping keeps the file open
+		if (bytes > 0 && address == nullptr) {
+			throw std::runtime_error("MappedArray: cannot map " + fname);
+		}
+#endif
+	}
+
+	~FileMapping() { unmap(); }
+
+	FileMapping(const FileMapping &) = delete;
+	FileMapping& operator=(const FileMapping &) = delete;
+
+	void unmap()
+	{
+#if defined(_WIN32)
+		if (address != nullptr) { UnmapViewOfFile(address); }
+		if (mapping != NULL) { CloseHandle(mapping); }
+		if (file != INVALID_HANDLE_VALUE) { CloseHandle(file); }
+		mapping = NULL;
+		file = INVALID_HANDLE_VALUE;
+#else
+		if (address != nullptr) { ::munmap(address, bytes); }
+#endif
+		address = nullptr;
+	}
+};
+
+template <class T, class Bounds = CheckedBounds>
+class MappedArray : private FileMapping, public Array<T, Bounds>
+{
+	static_assert(std::is_trivially_copyable<T>::value, "MappedArray: T must be trivially copyable");
+
+public:
+	explicit MappedArray(const std::string & fname, MapMode mode=MAP_COPY_ON_WRITE);
+
+	MapMode mode() const;
+	bool isMapped() const;
+
+	static void save(const Array<T, Bounds> & data, const std::string & fname);
+
+private:
+	static MapMode writable(MapMode mode);
+
+	MapMode mapMode;
+};
+
+// Read only mapping, whose elements are viewed through an ArraySpan<const T>
+template <class T, class Bounds>
+class MappedArray<const T, Bounds> : private FileMapping, public ArraySpan<const T>
+{
+	static_assert(std::is_trivially_copyable<T>::value, "MappedArray: T must be trivially copyable");
+
+public:
+	explicit MappedArray(const std::string & fname);
+
+	MapMode mode() const	{ return MAP_READ_ONLY; }
+	bool isMapped() const	{ return true; }
+};
+
+// ========================= IMPLEMENTATION MappedArray.cpp ===================================
+
+// PreCondition: named file exists and holds fixed width T records (a partial
+//               trailing record is ignored)
+// PostCondition: array of the records in the file, mapped in the specified mode
+template <class T, class Bounds>
+MappedArray<T, Bounds>::MappedArray(const std::string & fname, MapMode mode)
+	: FileMapping(fname, writable(mode)),
+	  Array<T, Bounds>(static_cast<T*>(this->address), (int)(this->bytes / sizeof(T)), 0),
+	  mapMode(mode)
+{
+	this->adopt((int)(this->bytes / sizeof(T)));
+}
+
+// PostCondition: returns mode, throws invalid_argument if it is MAP_READ_ONLY, as writes
+//                through the Array would then fault rather than raise an error
+template <class T, class Bounds>
+MapMode MappedArray<T, Bounds>::writable(MapMode mode)
+{
+	if (mode == MAP_READ_ONLY) {
+		throw std::invalid_argument("MappedArray: map a read only file as MappedArray<const T>");
+	}
+	return mode;
+}
+
+// PreCondition: named file exists and holds fixed width T records
+// PostCondition: read only view of the records in the file
+template <class T, class Bounds>
+MappedArray<const T, Bounds>::MappedArray(const std::string & fname)
+	: FileMapping(fname, MAP_READ_ONLY),
+	  ArraySpan<const T>(static_cast<const T*>(this->address), (int)(this->bytes / sizeof(T))) {}
+
+// PostCondition: returns the mode the file was mapped with
+template <class T, class Bounds>
+MapMode MappedArray<T, Bounds>::mode() const
+{
+	return mapMode;
+}
+
+// PostCondition: returns true while elements are held in the mapped file
+template <class T, class Bounds>
+bool MappedArray<T, Bounds>::isMapped() const
+{
+	return this->isBorrowed();
+}
+
+// PreCondition: None
+// PostCondition: elements of data written to named file as fixed width records
+//                with a single bulk write, throws runtime_error on failure
+template <class T, class Bounds>
+void MappedArray<T, Bounds>::save(const Array<T, Bounds> & data, const std::string & fname)
+{
+	std::ofstream ofile(fname.c_str(), std::ios::binary | std::ios::trunc);
+	if (ofile.fail()) {
+		throw std::runtime_error("MappedArray: cannot create " + fname);
+	}
+	ofile.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)sizeof(T) * data.length());
+	if (ofile.fail()) {
+		throw std::runtime_error("MappedArray: cannot write " + fname);
+	}
+}
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * MpmcQueue.h
+ *
+ * Bounded lock free Queue for any number of producer and consumer threads
+ * (Vyukov). Each slot carries a sequence number saying whose turn it is:
+ * slot i & mask is free for the enqueue numbered i when its sequence is i,
+ * and holds the element for the dequeue numbered i when it is i + 1. A
+ * thread claims a number by advancing enqueuePos (or dequeuePos) with a CAS,
+ * fills or empties the slot, then passes the slot on by storing its next
+ * sequence, so producers and consumers only contend on their own index.
+ *
+ * The ring is the power of two >= n slots, but the queue holds at most n
+ * elements, as ArrayQueue and SpscQueue do. When n is not a power of two an
+ * enqueue also checks it is fewer than n ahead of dequeuePos before claiming.
+ *
+ * tryEnqueue and tryDequeue return false rather than wait. enqueue and
+ * dequeue wait, by yielding, until there is room or an element.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.2
+ */
+
+#ifndef MPMCQUEUE_H_
+#define MPMCQUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include "AlignedArray.h"
+
+template <class T>
+class MpmcQueue {
+public:
+	explicit MpmcQueue(int n=100);
+	~MpmcQueue();
+	MpmcQueue(const MpmcQueue &) = delete;
+	MpmcQueue & operator=(const MpmcQueue &) = delete;
+
+	bool tryEnqueue(const T & x);
+	bool tryDequeue(T & x);
+	void enqueue(const T & x);
+	void dequeue(T & x);
+
+	// a snapshot that may be out of date when used
+	bool isEmpty() const;
+	int  size() const;
+	int  capacity() const;
+
+private:
+	struct Slot {
+		std::atomic<std::size_t> sequence;
+		T data;
+	};
+
+	static int ringSize(int n);
+
+	Slot *slots;
+	std::size_t mask;
+	int  limit;								// most elements held
+
+	// each index on a cache line of its own, the queue rounded up to whole lines
+	alignas(CACHE_LINE) std::atomic<std::size_t> enqueuePos;	// number of the next enqueue
+	alignas(CACHE_LINE) std::atomic<std::size_t> dequeuePos;	// number of the next dequeue
+};
+
+// ========================= IMPLEMENTATION MpmcQueue.cpp ===================================
+
+// PostCondition: empty queue of capacity n, with a ring of the power of two >= n slots
+template <class T>
+MpmcQueue<T>::MpmcQueue(int n)
+	: slots(new Slot[ringSize(n)]), mask(ringSize(n) - 1), limit{ std::max(n, 1) }, enqueuePos(0), dequeuePos(0) {
+	for (std::size_t i = 0; i <= mask; i++) {
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+template <class T>
+MpmcQueue<T>::~MpmcQueue() {
+	delete[] slots;
+}
+
+// PostCondition: returns smallest power of two >= n, at least 2 as a one slot ring
+//                cannot tell a free slot from a full one
+template <class T>
+int MpmcQueue<T>::ringSize(int n) {
+	int size = 2;
+	while (size < n) {
+		size *= 2;
+	}
+	return size;
+}
+
+// PostCondition: x added to end of the queue and true returned, or false if full
+template <class T>
+bool MpmcQueue<T>::tryEnqueue(const T & x) {
+	std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+	Slot *slot;
+	for (;;) {
+		slot = &slots[pos & mask];
+		std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+		if (diff == 0) {
+			// slot free for enqueue pos - claim it, unless the ring is larger than limit and
+			// limit elements are already claimed. dequeuePos only grows, so reading it late
+			// can only make the queue look fuller than it is
+			if (limit <= (int)mask && (std::ptrdiff_t)(pos - dequeuePos.load(std::memory_order_relaxed)) >= limit) {
+				return false;
+			}
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return false;		// slot still holds the element from a lap ago - full
+		} else {
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+	slot->data = x;
+	slot->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+// PostCondition: least recently claimed element moved to x, removed and true returned,
+//                or false if empty
+template <class T>
+bool MpmcQueue<T>::tryDequeue(T & x) {
+	std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+	Slot *slot;
+	for (;;) {
+		slot = &slots[pos & mask];
+		std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1);
+		if (diff == 0) {
+			// slot filled for dequeue pos - claim it
+			if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return false;		// slot not yet filled - empty
+		} else {
+			pos = dequeuePos.load(std::memory_order_relaxed);
+		}
+	}
+	x = std::move(slot->data);
+	slot->sequence.store(pos + mask + 1, std::memory_order_release);	// free for the next lap
+	return true;
+}
+
+// PostCondition: x added to end of the queue, waiting for room if full
+template <class T>
+void MpmcQueue<T>::enqueue(const T & x) {
+	while (!tryEnqueue(x)) {
+		std::this_thread::yield();
+	}
+}
+
+// PostCondition: least recently claimed element moved to x and removed, waiting for one
+//                if empty
+template <class T>
+void MpmcQueue<T>::dequeue(T & x) {
+	while (!tryDequeue(x)) {
+		std::this_thread::yield();
+	}
+}
+
+// PostCondition: return number of elements claimed for enqueue and not yet for dequeue
+template <class T>
+int MpmcQueue<T>::size() const {
+	std::size_t d = dequeuePos.load(std::memory_order_acquire);
+	std::size_t e = enqueuePos.load(std::memory_order_acquire);
+	std::ptrdiff_t n = (std::ptrdiff_t)(e - d);
+	return (int)std::max<std::ptrdiff_t>(0, std::min<std::ptrdiff_t>(n, capacity()));
+}
+
+template <class T>
+bool MpmcQueue<T>::isEmpty() const {
+	return size() == 0;
+}
+
+template <class T>
+int MpmcQueue<T>::capacity() const {
+	return limit;
+}
+
+#endif
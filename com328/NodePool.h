@@ -0,0 +1,266 @@
+/**
+ * NodePool.h
+ *
+ * Node allocation policies for the node based containers (LinkedList,
+ * DLinkedList and BinaryTree), selected by their Nodes template parameter.
+ *
+ * NodePool<N> (the default) gives each container its own pool of N sized
+ * slots. Slots are carved from slabs that double in size up to MAX_SLAB
+ * slots, so nodes allocated together sit together in memory, and a slot
+ * freed by destroy is kept on a free list for the next create. clear() in
+ * the containers releases every node at once with reset(), running no
+ * per node code at all when the node type is trivially destructible.
+ *
+ * Lists splicing nodes between them merge their pools in O(1): the pools
+ * then share one registry of slabs, freed when the last of them is done,
+ * so the nodes each now holds stay valid for as long as any of them is
+ * alive. A pool in a shared registry leaves it on reset(), taking no slab.
+ *
+ * HeapNodes<N> allocates each node with new and delete, as the containers
+ * did originally.
+ *
+ * A policy provides
+ *   create(args...)  construct a node
+ *   destroy(n)       destruct a node and free its storage
+ *   discard(n)       destruct a node that is about to be freed by reset()
+ *   reset()          free every node created so far
+ *   merge(other)     allow destroy of nodes created by other
+ *   discardIsTrivial()  true when discard does nothing, so it need not be called
+ *
+ * A pool belongs to one container, which is not thread safe, so needs no
+ * locking; a copy of a container starts with a new, empty pool.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.2
+ */
+
+#ifndef NODEPOOL_H_
+#define NODEPOOL_H_
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <class N>
+class NodePool {
+public:
+	static const int FIRST_SLAB = 16;
+	static const int MAX_SLAB = 4096;
+
+	NodePool();
+	~NodePool();
+	NodePool(const NodePool &) = delete;
+	NodePool & operator=(const NodePool &) = delete;
+
+	template <class... Args>
+	N*   create(Args&&... args);
+	void destroy(N *n);
+	void discard(N *n);
+	void reset();
+	void merge(NodePool & other);
+	bool discardIsTrivial() const { return std::is_trivially_destructible<N>::value; }
+
+	int  live() const		{ return used; }
+	int  capacity() const	{ return slots; }
+
+private:
+	union Slot {
+		Slot *next;
+		typename std::aligned_storage<sizeof(N), alignof(N)>::type node;
+	};
+
+	struct Slab {
+		Slot *slots;
+		int   size;
+		Slab *next;
+		explicit Slab(int size) : slots(static_cast<Slot*>(::operator new(sizeof(Slot) * size))), size(size), next(nullptr) {}
+		~Slab() { ::operator delete(slots); }
+	};
+
+	// slabs of every pool merged together. A merge moves the slabs of one registry
+	// to the other and leaves it pointing there, so its pools find them on their next use
+	struct Registry {
+		Slab *first;					// most recent first
+		Slab *last;
+		std::shared_ptr<Registry> into;	// registry the slabs were moved to, or empty
+		Registry() : first(nullptr), last(nullptr) {}
+		~Registry();
+	};
+
+	std::shared_ptr<Registry> registry;	// created with the first slab
+	Slab *current;		// slab new slots are taken from, only ever by this pool
+	Slot *freeList;		// slots released by destroy
+	Slot *bump;			// next unused slot of the current slab
+	Slot *limit;		// end of the current slab
+	int   used;
+	int   slots;
+
+	Registry & root();
+	void addSlab();
+};
+
+template <class N>
+class HeapNodes {
+public:
+	template <class... Args>
+	N*   create(Args&&... args)	{ return new N(std::forward<Args>(args)...); }
+	void destroy(N *n)			{ delete n; }
+	void discard(N *n)			{ delete n; }
+	void reset()				{}
+	void merge(HeapNodes &)		{}
+	bool discardIsTrivial() const { return false; }
+};
+
+// ========================= IMPLEMENTATION NodePool.cpp ===================================
+
+template <class N>
+NodePool<N>::NodePool() : current(nullptr), freeList(nullptr), bump(nullptr), limit(nullptr), used(0), slots(0) {}
+
+// PostCondition: slabs returned to the heap unless shared with another pool - nodes must
+//                have been destroyed or discarded
+template <class N>
+NodePool<N>::~NodePool() {}
+
+// PostCondition: returns node constructed from args in a free slot, adding a slab if required
+template <class N>
+template <class... Args>
+N* NodePool<N>::create(Args&&... args) {
+	Slot *s;
+	if (freeList != nullptr) {
+		s = freeList;
+		freeList = freeList->next;
+	} else {
+		if (bump == limit) {
+			addSlab();
+		}
+		s = bump++;
+	}
+	N *n = new (&s->node) N(std::forward<Args>(args)...);
+	used++;
+	return n;
+}
+
+// PreCondition: n was created by this pool
+// PostCondition: n destructed and its slot kept for reuse
+template <class N>
+void NodePool<N>::destroy(N *n) {
+	n->~N();
+	Slot *s = reinterpret_cast<Slot*>(n);
+	s->next = freeList;
+	freeList = s;
+	used--;
+}
+
+// PreCondition: n was created by this pool and reset() is called before the next create
+// PostCondition: n destructed, its slot is reclaimed by reset()
+template <class N>
+void NodePool<N>::discard(N *n) {
+	n->~N();
+}
+
+// PreCondition: every node created has been destroyed or discarded
+// PostCondition: every slot is free. The current (largest) slab is kept for reuse and the
+//                rest returned to the heap, so a cleared container does not hold on to its
+//                peak. A pool sharing its slabs leaves them to the others and keeps none
+template <class N>
+void NodePool<N>::reset() {
+	if (registry) {
+		root();
+	}
+	if (registry.use_count() == 1 && current != nullptr) {
+		Slab *s = registry->first;
+		while (s != nullptr) {
+			Slab *next = s->next;
+			if (s != current) {
+				delete s;
+			}
+			s = next;
+		}
+		current->next = nullptr;
+		registry->first = registry->last = current;
+		slots = current->size;
+		bump = current->slots;
+		limit = current->slots + current->size;
+	} else {
+		registry.reset();
+		current = nullptr;
+		bump = limit = nullptr;
+		slots = 0;
+	}
+	freeList = nullptr;
+	used = 0;
+}
+
+// PostCondition: this pool and other share one registry of slabs, so each may destroy
+//                nodes the other created. O(1), plus following earlier merges once
+template <class N>
+void NodePool<N>::merge(NodePool<N> & other) {
+	if (!other.registry) {
+		return;						// other has created no nodes
+	}
+	if (!registry) {
+		other.root();
+		registry = other.registry;
+		return;
+	}
+	Registry & mine = root();
+	Registry & theirs = other.root();
+	if (&mine == &theirs) {
+		return;
+	}
+	if (theirs.first != nullptr) {
+		theirs.last->next = mine.first;
+		if (mine.first == nullptr) {
+			mine.last = theirs.last;
+		}
+		mine.first = theirs.first;
+		theirs.first = theirs.last = nullptr;
+	}
+	theirs.into = registry;
+	other.registry = registry;
+}
+
+// PreCondition: registry is not empty
+// PostCondition: returns registry holding the slabs of this pool, after moving this pool
+//                on to it past any registries merged since
+template <class N>
+typename NodePool<N>::Registry & NodePool<N>::root() {
+	while (registry->into) {
+		std::shared_ptr<Registry> into = registry->into;
+		registry = into;
+	}
+	return *registry;
+}
+
+// PostCondition: new slab, twice the size of the current one up to MAX_SLAB, is current
+template <class N>
+void NodePool<N>::addSlab() {
+	int size = (current == nullptr) ? FIRST_SLAB : (current->size < MAX_SLAB ? current->size * 2 : MAX_SLAB);
+	if (!registry) {
+		registry = std::make_shared<Registry>();
+	}
+	Registry & r = root();
+	current = new Slab(size);
+	current->next = r.first;
+	r.first = current;
+	if (r.last == nullptr) {
+		r.last = current;
+	}
+	slots += size;
+	bump = current->slots;
+	limit = current->slots + size;
+}
+
+// PostCondition: slabs still held are returned to the heap
+template <class N>
+NodePool<N>::Registry::~Registry() {
+	while (first != nullptr) {
+		Slab *next = first->next;
+		delete first;
+		first = next;
+	}
+}
+
+#endif
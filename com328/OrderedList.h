@@ -5,7 +5,7 @@
 *
 * @author  Aiden McCaughey
 * @email   a.mccaughey@ulster.ac.uk
-* @version 1.2
+* @version 1.3
 *
 */
 
@@ -13,6 +13,7 @@
 #define ORDEREDLIST_H
 
 #include "ArrayList.h"
+#include <algorithm>
 
 template <class T>
 class OrderedList : public ArrayList<T>
@@ -37,6 +38,22 @@ public:
 	// override invalid operations
 	void add(int pos, const T & e);
 	void set(int pos, const T & e);
+	template <class... Args>
+	void emplace(int pos, Args&&... args);
+	template <class U>
+	void addAll(int pos, const ArraySpan<U> & range);
+	void addAll(int pos, const ArrayList<T> & other);
+
+	// hide writable element access, which could break the ordering
+	const T& operator[](int pos) const { return ArrayList<T>::at(pos); }
+	const T* data() const { return ArrayList<T>::data(); }
+	const T* begin() const { return ArrayList<T>::begin(); }
+	const T* end() const { return ArrayList<T>::end(); }
+	ArraySpan<const T>   span() const { return ArrayList<T>::span(); }
+	ReverseSpan<const T> reverse() const { return ArrayList<T>::reverse(); }
+	ArraySpan<const T>   take(int n) const { return ArrayList<T>::take(n); }
+	ArraySpan<const T>   drop(int n) const { return ArrayList<T>::drop(n); }
+	ArraySpan<const T>   mid(int start, int n) const { return ArrayList<T>::mid(start, n); }
 
 };
 
@@ -45,8 +62,8 @@ template <class T>
 OrderedList<T>::OrderedList(const ArrayList<T> & data) : ArrayList<T>(data.size()) 
 {
 	// calling orderedlist add function ensures elements are added in order
-	for (int i = 0; i < data.size(); i++) {
-		add(data.get(i));
+	for (const T & e : data) {
+		add(e);
 	}
 }
 
@@ -54,14 +71,14 @@ OrderedList<T>::OrderedList(const ArrayList<T> & data) : ArrayList<T>(data.size(
 template <class T>
 T OrderedList<T>::first() const
 {
-	return ArrayList<T>::get(0);
+	return ArrayList<T>::at(0);
 }
 
 // PreCondition: isEmpty() == false
 template <class T>
 T OrderedList<T>::last() const
 {
-	return ArrayList<T>::get(ArrayList<T>::size()-1); 
+	return ArrayList<T>::at(ArrayList<T>::size()-1); 
 }
 
 // PreCondition:: none
@@ -69,13 +86,12 @@ T OrderedList<T>::last() const
 template <class T>
 void OrderedList<T>::add(const T & e)
 {        
-	// locate correct position to insert
-	int pos;
-	for (pos = 0; pos < ArrayList<T>::size() && e > ArrayList<T>::get(pos); pos++) {};
+	// locate correct position to insert - before the first element not less than e
+	const T *pos = std::lower_bound(begin(), end(), e, [](const T & x, const T & v) { return v > x; });
 
 	// add element at ordered position
 	// important to call superclass ArrayList add function
-	ArrayList<T>::add(pos,e);   
+	ArrayList<T>::add((int)(pos - begin()), e);
 }
 
 // PreCondition:: elements in list are ordered
@@ -86,9 +102,10 @@ int OrderedList<T>::find(const T & e) const {
    int right = ArrayList<T>::size()-1;		// set right boundary	
    while (left <= right) {		// continue search?
       int pivot = (left + right) / 2;
-      if (e == ArrayList<T>::get(pivot)) {	
+      const T & p = ArrayList<T>::at(pivot);
+      if (e == p) {	
          return pivot;			// found
-      } else if (e > ArrayList<T>::get(pivot)) { 
+      } else if (e > p) { 
          left = pivot + 1;		// search to right
       } else {
          right = pivot - 1;		// search to left
@@ -114,4 +131,28 @@ void OrderedList<T>::add(int pos, const T & e)
 	throw std::runtime_error("invalid operation on an Ordered List");
 }
 
+// PreCondition: method call is invalid as elements placed at pos could break the ordering
+// PostCondition: calling this method will throw an exception 
+template <class T>
+template <class... Args>
+void OrderedList<T>::emplace(int, Args&&...)
+{
+	throw std::runtime_error("invalid operation on an Ordered List");
+}
+
+// PreCondition: method call is invalid as elements placed at pos could break the ordering
+// PostCondition: calling this method will throw an exception 
+template <class T>
+template <class U>
+void OrderedList<T>::addAll(int, const ArraySpan<U> &)
+{
+	throw std::runtime_error("invalid operation on an Ordered List");
+}
+
+template <class T>
+void OrderedList<T>::addAll(int, const ArrayList<T> &)
+{
+	throw std::runtime_error("invalid operation on an Ordered List");
+}
+
 #endif /* ORDEREDLIST_H */
@@ -0,0 +1,497 @@
+/**
+ * PersistentVector.h
+ *
+ * Immutable list offering the ArrayList processing functions (reverse, take,
+ * drop, concat, mid) plus set, add and remove, each returning a new version
+ * and leaving the original unchanged. Versions share structure, so keeping
+ * many versions of a large list costs O(log n) per version, not O(n).
+ *
+ * The elements are held in leaves of up to CHUNK contiguous elements under a
+ * height balanced (AVL) tree whose nodes record the number of elements below
+ * them. Nodes are never modified once built, so they are shared freely:
+ *   get                                    O(log n)
+ *   set, add, remove, take, drop, mid      O(log n) new nodes
+ *   concat                                 O(log n) new nodes
+ *   ==                                     O(log n) plus the elements not shared
+ *   reverse, find, print                   O(n)
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.1
+ */
+
+#ifndef PERSISTENTVECTOR_H_
+#define PERSISTENTVECTOR_H_
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "Array.h"
+#include "ArraySpan.h"
+#include "ArrayList.h"
+
+template <class T>
+class PersistentVector {
+public:
+	PersistentVector();
+	PersistentVector(ArraySpan<const T> elements);
+	template <class Bounds, class Storage>
+	explicit PersistentVector(const ArrayList<T, Bounds, Storage> & list);
+
+	bool operator==(const PersistentVector & other) const;
+	bool operator!=(const PersistentVector & other) const;
+
+	T    get(int pos) const;
+	int  find(const T & value) const;
+	int  size() const;
+	bool isEmpty() const;
+	int  height() const;
+	void print(std::ostream & os) const;
+	ArrayList<T> toArrayList() const;
+
+	// Versioning functions - each returns a new version sharing structure with this one
+	PersistentVector set(int pos, const T & value) const;
+	PersistentVector add(const T & value) const;
+	PersistentVector add(int pos, const T & value) const;
+	PersistentVector remove(int pos) const;
+
+	// Immutable List processing functions
+	PersistentVector reverse() const;
+	PersistentVector take(int n) const;
+	PersistentVector drop(int n) const;
+	PersistentVector concat(const PersistentVector & other) const;
+	PersistentVector mid(int start, int count) const;
+
+private:
+	static const int CHUNK = 32;	// maximum elements in a leaf
+	static const int MAX_HEIGHT = 64;	// well above the AVL bound for INT_MAX elements
+
+	struct Node;
+	typedef std::shared_ptr<const Node> Ref;
+
+	// a leaf holds elements in chunk, a branch holds left and right subtrees
+	struct Node {
+		int size;
+		int height;
+		Ref left, right;
+		Array<T> chunk;
+
+		Node(const Ref & l, const Ref & r);
+		explicit Node(Array<T> && c);
+		bool isLeaf() const { return left == nullptr; }
+	};
+
+	// position in an in order walk of a tree, holding the subtrees still to visit
+	struct Cursor {
+		const Node *pending[MAX_HEIGHT];
+		int depth;
+		int offset;		// elements of the leaf on top already visited
+
+		explicit Cursor(const Ref & root);
+		const Node * top() const { return pending[depth - 1]; }
+		void expand();
+		void skip(int n);
+	};
+
+	Ref root;
+
+	explicit PersistentVector(const Ref & r) : root(r) {}
+
+	static int sizeOf(const Ref & n)   { return n ? n->size : 0; }
+	static int heightOf(const Ref & n) { return n ? n->height : 0; }
+
+	static Ref  leaf(const T *p, int n);
+	static Ref  build(const T *p, int n);
+	static Ref  balance(const Ref & l, const Ref & r);
+	static Ref  join(const Ref & l, const Ref & r);
+	static void split(const Ref & n, int i, Ref & left, Ref & right);
+	static Ref  setAt(const Ref & n, int i, const T & value);
+	template <class Action>
+	static bool visit(const Ref & n, Action & action);
+	void checkPosition(int pos, int limit) const;
+};
+
+// ========================= IMPLEMENTATION PersistentVector.cpp ===================================
+
+template <class T>
+PersistentVector<T>::Node::Node(const Ref & l, const Ref & r)
+	: size(sizeOf(l) + sizeOf(r)), height(1 + (heightOf(l) > heightOf(r) ? heightOf(l) : heightOf(r))),
+	  left(l), right(r), chunk(0) {}
+
+template <class T>
+PersistentVector<T>::Node::Node(Array<T> && c) : size(c.length()), height(1), chunk(std::move(c)) {}
+
+// PostCondition: empty vector
+template <class T>
+PersistentVector<T>::PersistentVector() {}
+
+// PostCondition: vector holding a copy of the elements, built balanced in O(n)
+template <class T>
+PersistentVector<T>::PersistentVector(ArraySpan<const T> elements) : root(build(elements.data(), elements.length())) {}
+
+template <class T>
+template <class Bounds, class Storage>
+PersistentVector<T>::PersistentVector(const ArrayList<T, Bounds, Storage> & list) : root(build(list.span().data(), list.size())) {}
+
+// PostCondition: returns true if both versions hold equal elements in the same order.
+//                Both trees are walked together, always opening the larger subtree, so
+//                a subtree shared by both at the same position is skipped without a look
+template <class T>
+bool PersistentVector<T>::operator==(const PersistentVector<T> & other) const {
+	if (size() != other.size()) {
+		return false;
+	}
+	Cursor a(root), b(other.root);
+	while (a.depth > 0) {
+		const Node *x = a.top();
+		const Node *y = b.top();
+		if (x == y && a.offset == 0 && b.offset == 0) {
+			a.skip(x->size);
+			b.skip(y->size);
+		} else if (!x->isLeaf() && (y->isLeaf() || x->size >= y->size)) {
+			a.expand();
+		} else if (!y->isLeaf()) {
+			b.expand();
+		} else {
+			int n = (x->size - a.offset < y->size - b.offset) ? x->size - a.offset : y->size - b.offset;
+			for (int i = 0; i < n; i++) {
+				if (!(x->chunk.unchecked_at(a.offset + i) == y->chunk.unchecked_at(b.offset + i))) {
+					return false;
+				}
+			}
+			a.skip(n);
+			b.skip(n);
+		}
+	}
+	return true;
+}
+
+template <class T>
+bool PersistentVector<T>::operator!=(const PersistentVector<T> & other) const {
+	return !operator==(other);
+}
+
+// PreCondition: pos is a valid position
+// PostCondition: returns element at pos
+template <class T>
+T PersistentVector<T>::get(int pos) const {
+	checkPosition(pos, size());
+	const Node *n = root.get();
+	while (!n->isLeaf()) {
+		if (pos < n->left->size) {
+			n = n->left.get();
+		} else {
+			pos -= n->left->size;
+			n = n->right.get();
+		}
+	}
+	return n->chunk.unchecked_at(pos);
+}
+
+// PostCondition: returns position of value, or -1 if not found
+template <class T>
+int PersistentVector<T>::find(const T & value) const {
+	int i = 0;
+	auto match = [&](const T & v) { if (v == value) { return false; } i++; return true; };
+	return visit(root, match) ? -1 : i;
+}
+
+template <class T>
+int PersistentVector<T>::size() const {
+	return sizeOf(root);
+}
+
+template <class T>
+bool PersistentVector<T>::isEmpty() const {
+	return root == nullptr;
+}
+
+// PostCondition: returns number of levels in the tree, O(log n) for n elements
+template <class T>
+int PersistentVector<T>::height() const {
+	return heightOf(root);
+}
+
+template <class T>
+void PersistentVector<T>::print(std::ostream & os) const {
+	os << "[ ";
+	auto out = [&](const T & v) { os << v << " "; return true; };
+	visit(root, out);
+	os << "]";
+}
+
+// PostCondition: returns an ArrayList holding a copy of the elements
+template <class T>
+ArrayList<T> PersistentVector<T>::toArrayList() const {
+	ArrayList<T> list(size());
+	auto add = [&](const T & v) { list.add(v); return true; };
+	visit(root, add);
+	return list;
+}
+
+// PreCondition: pos is a valid position
+// PostCondition: new version with element at pos replaced by value
+template <class T>
+PersistentVector<T> PersistentVector<T>::set(int pos, const T & value) const {
+	checkPosition(pos, size());
+	return PersistentVector<T>(setAt(root, pos, value));
+}
+
+// PostCondition: new version with value appended
+template <class T>
+PersistentVector<T> PersistentVector<T>::add(const T & value) const {
+	return PersistentVector<T>(join(root, leaf(&value, 1)));
+}
+
+// PreCondition: 0 <= pos <= size()
+// PostCondition: new version with value inserted at pos
+template <class T>
+PersistentVector<T> PersistentVector<T>::add(int pos, const T & value) const {
+	checkPosition(pos, size() + 1);
+	Ref l, r;
+	split(root, pos, l, r);
+	return PersistentVector<T>(join(join(l, leaf(&value, 1)), r));
+}
+
+// PreCondition: pos is a valid position
+// PostCondition: new version without the element at pos
+template <class T>
+PersistentVector<T> PersistentVector<T>::remove(int pos) const {
+	checkPosition(pos, size());
+	Ref l, r, removed, rest;
+	split(root, pos, l, r);
+	split(r, 1, removed, rest);
+	return PersistentVector<T>(join(l, rest));
+}
+
+// PostCondition: new version holding the elements in reverse order
+template <class T>
+PersistentVector<T> PersistentVector<T>::reverse() const {
+	Array<T> a(size());
+	int i = size();
+	auto fill = [&](const T & v) { a.unchecked_at(--i) = v; return true; };
+	visit(root, fill);
+	return PersistentVector<T>(build(a.data(), a.length()));
+}
+
+// PreCondition: 0 <= n <= size()
+// PostCondition: new version holding the first n elements
+template <class T>
+PersistentVector<T> PersistentVector<T>::take(int n) const {
+	if (n < 0 || n > size()) {
+		throw std::out_of_range("PersistentVector: invalid number of elements to take: " + std::to_string(n));
+	}
+	Ref l, r;
+	split(root, n, l, r);
+	return PersistentVector<T>(l);
+}
+
+// PreCondition: 0 <= n <= size()
+// PostCondition: new version holding all but the first n elements
+template <class T>
+PersistentVector<T> PersistentVector<T>::drop(int n) const {
+	if (n < 0 || n > size()) {
+		throw std::out_of_range("PersistentVector: invalid number of elements to drop: " + std::to_string(n));
+	}
+	Ref l, r;
+	split(root, n, l, r);
+	return PersistentVector<T>(r);
+}
+
+// PostCondition: new version holding the elements of this followed by those of other
+template <class T>
+PersistentVector<T> PersistentVector<T>::concat(const PersistentVector<T> & other) const {
+	return PersistentVector<T>(join(root, other.root));
+}
+
+// PreCondition: start >= 0 && start < size() && count <= (size() - start)
+template <class T>
+PersistentVector<T> PersistentVector<T>::mid(int start, int count) const {
+	if (start < 0 || start >= size() || count < 0 || count > size() - start) {
+		throw std::out_of_range("PersistentVector: mid(" + std::to_string(start) + "," + std::to_string(count) + ") invalid");
+	}
+	return drop(start).take(count);
+}
+
+// ------------------ Private tree management -------------------------
+
+// PostCondition: leaf holding a copy of n elements at p, or null when n is 0
+template <class T>
+typename PersistentVector<T>::Ref PersistentVector<T>::leaf(const T *p, int n) {
+	if (n <= 0) {
+		return Ref();
+	}
+	Array<T> chunk(n);
+	for (int i = 0; i < n; i++) {
+		chunk.unchecked_at(i) = p[i];
+	}
+	return std::make_shared<const Node>(std::move(chunk));
+}
+
+// PostCondition: perfectly balanced tree of full leaves holding n elements at p
+template <class T>
+typename PersistentVector<T>::Ref PersistentVector<T>::build(const T *p, int n) {
+	if (n <= CHUNK) {
+		return leaf(p, n);
+	}
+	int leaves = (n + CHUNK - 1) / CHUNK;
+	int half = (leaves / 2) * CHUNK;
+	return std::make_shared<const Node>(build(p, half), build(p + half, n - half));
+}
+
+// PreCondition: heights of l and r differ by at most 2
+// PostCondition: balanced branch holding l followed by r, rotating once when required
+template <class T>
+typename PersistentVector<T>::Ref PersistentVector<T>::balance(const Ref & l, const Ref & r) {
+	if (heightOf(l) > heightOf(r) + 1) {
+		if (heightOf(l->left) >= heightOf(l->right)) {
+			return std::make_shared<const Node>(l->left, std::make_shared<const Node>(l->right, r));
+		}
+		return std::make_shared<const Node>(std::make_shared<const Node>(l->left, l->right->left),
+		                                    std::make_shared<const Node>(l->right->right, r));
+	}
+	if (heightOf(r) > heightOf(l) + 1) {
+		if (heightOf(r->right) >= heightOf(r->left)) {
+			return std::make_shared<const Node>(std::make_shared<const Node>(l, r->left), r->right);
+		}
+		return std::make_shared<const Node>(std::make_shared<const Node>(l, r->left->left),
+		                                    std::make_shared<const Node>(r->left->right, r->right));
+	}
+	return std::make_shared<const Node>(l, r);
+}
+
+// PostCondition: balanced tree holding l followed by r, descending the taller tree
+//                only as far as the height of the shorter. Adjacent small leaves are merged
+template <class T>
+typename PersistentVector<T>::Ref PersistentVector<T>::join(const Ref & l, const Ref & r) {
+	if (!l) {
+		return r;
+	}
+	if (!r) {
+		return l;
+	}
+	if (l->isLeaf() && r->isLeaf() && l->size + r->size <= CHUNK) {
+		Array<T> chunk(l->size + r->size);
+		for (int i = 0; i < l->size; i++) {
+			chunk.unchecked_at(i) = l->chunk.unchecked_at(i);
+		}
+		for (int i = 0; i < r->size; i++) {
+			chunk.unchecked_at(l->size + i) = r->chunk.unchecked_at(i);
+		}
+		return std::make_shared<const Node>(std::move(chunk));
+	}
+	if (l->height > r->height + 1) {
+		return balance(l->left, join(l->right, r));
+	}
+	if (r->height > l->height + 1) {
+		return balance(join(l, r->left), r->right);
+	}
+	return std::make_shared<const Node>(l, r);
+}
+
+// PreCondition: 0 <= i <= sizeOf(n)
+// PostCondition: left holds the first i elements of n and right the rest
+template <class T>
+void PersistentVector<T>::split(const Ref & n, int i, Ref & left, Ref & right) {
+	if (!n) {
+		left = right = Ref();
+	} else if (i == 0) {
+		left = Ref();
+		right = n;
+	} else if (i == n->size) {
+		left = n;
+		right = Ref();
+	} else if (n->isLeaf()) {
+		left = leaf(n->chunk.data(), i);
+		right = leaf(n->chunk.data() + i, n->size - i);
+	} else if (i <= n->left->size) {
+		Ref l, r;
+		split(n->left, i, l, r);
+		left = l;
+		right = join(r, n->right);
+	} else {
+		Ref l, r;
+		split(n->right, i - n->left->size, l, r);
+		left = join(n->left, l);
+		right = r;
+	}
+}
+
+// PreCondition: 0 <= i < sizeOf(n)
+// PostCondition: copy of the path to element i, with element i replaced by value
+template <class T>
+typename PersistentVector<T>::Ref PersistentVector<T>::setAt(const Ref & n, int i, const T & value) {
+	if (n->isLeaf()) {
+		Array<T> chunk(n->chunk);
+		chunk.unchecked_at(i) = value;
+		return std::make_shared<const Node>(std::move(chunk));
+	}
+	if (i < n->left->size) {
+		return std::make_shared<const Node>(setAt(n->left, i, value), n->right);
+	}
+	return std::make_shared<const Node>(n->left, setAt(n->right, i - n->left->size, value));
+}
+
+// PostCondition: action called with each element in order until it returns false,
+//                returns false if stopped early
+template <class T>
+template <class Action>
+bool PersistentVector<T>::visit(const Ref & n, Action & action) {
+	if (!n) {
+		return true;
+	}
+	if (n->isLeaf()) {
+		for (int i = 0; i < n->size; i++) {
+			if (!action(n->chunk.unchecked_at(i))) {
+				return false;
+			}
+		}
+		return true;
+	}
+	return visit(n->left, action) && visit(n->right, action);
+}
+
+// PostCondition: walk positioned before the first element of root
+template <class T>
+PersistentVector<T>::Cursor::Cursor(const Ref & root) : depth(0), offset(0) {
+	if (root) {
+		pending[depth++] = root.get();
+	}
+}
+
+// PreCondition: top() is a branch
+// PostCondition: top() replaced by its children, left on top
+template <class T>
+void PersistentVector<T>::Cursor::expand() {
+	const Node *n = pending[--depth];
+	pending[depth++] = n->right.get();
+	pending[depth++] = n->left.get();
+}
+
+// PreCondition: n elements remain in top(), and n is all of them unless top() is a leaf
+// PostCondition: walk moved on n elements, dropping top() once it is finished
+template <class T>
+void PersistentVector<T>::Cursor::skip(int n) {
+	offset += n;
+	if (offset == top()->size) {
+		depth--;
+		offset = 0;
+	}
+}
+
+template <class T>
+void PersistentVector<T>::checkPosition(int pos, int limit) const {
+	if (pos < 0 || pos >= limit) {
+		throw std::out_of_range("PersistentVector: invalid position: " + std::to_string(pos));
+	}
+}
+
+// PostCondition: overload << operator to output vector on ostream
+template <class T>
+std::ostream& operator <<(std::ostream& output, const PersistentVector<T>& v) {
+	v.print(output);
+	return output;
+}
+
+#endif
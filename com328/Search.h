@@ -5,7 +5,7 @@
  *
  * @author  Aiden McCaughey
  * @email   a.mccaughey@ulster.ac.uk
- * @version 2.0
+ * @version 2.1
  */
 
 #ifndef SEARCH_H_
@@ -15,15 +15,26 @@
 //#define SEARCH_DEBUG_
 
 #include "Array.h"
+#include "ArraySpan.h"
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+// searches only visit positions in [0, length()) so they read elements
+// through unchecked_at rather than the checked operator[]
+
+// Each search accepts an Array, an ArraySpan or a ReverseSpan, so a subrange can be
+// searched in place. The algorithms themselves are the ...Of templates, written
+// against any Seq providing length() and unchecked_at().
 
 
 // PreCondition: data array is full
 // PostCondition: return true if array elements are in sorted order, otherwise false
-template <class T>
-bool isOrdered(const Array<T> & data) {
+template <class Seq>
+bool isOrderedOf(const Seq & data) {
     int i;
 	for(i=0; i<data.length()-1; i++) {
-		if (data[i] > data[i+1]) {
+		if (data.unchecked_at(i) > data.unchecked_at(i+1)) {
 
             #ifdef SEARCH_DEBUG_
         	std::cout << "\nisOrdered " <<  data << " took " << (i+1) << " passes" << std::endl;
@@ -42,13 +53,13 @@ bool isOrdered(const Array<T> & data) {
 
 // PreCondition: Data array is full
 // PostCondition: return position if val found in data array, otherwise -1
-template <class T>
-int sequentialSearch(const Array<T> & data, const T & val) {
+template <class Seq, class T>
+int sequentialSearchOf(const Seq & data, const T & val) {
     #ifdef SEARCH_DEBUG_
     std::cout << "\nSeqSearch: " << data << " for " << val;
     #endif
 	for(int i=0; i<data.length(); i++) {
-		if (data[i] == val) {
+		if (data.unchecked_at(i) == val) {
 
             #ifdef SEARCH_DEBUG_
             std::cout << " Found in " << (i+1) << " passes" << std::endl;
@@ -67,8 +78,8 @@ int sequentialSearch(const Array<T> & data, const T & val) {
 
 // PreCondition : Data array is full and is sorted
 // PostCondition: return position if val found, otherwise -1
-template <class T>
-int binarySearch(const Array<T> & data, const T & val) {
+template <class Seq, class T>
+int binarySearchOf(const Seq & data, const T & val) {
     int left = 0, right = data.length() - 1;
 
     #ifdef SEARCH_DEBUG_
@@ -82,9 +93,9 @@ int binarySearch(const Array<T> & data, const T & val) {
         std::cout << "Left=" << left << " Pivot=" << pivot << " Right=" << right << std::endl;
         #endif
 
-        if (data[pivot] == val) {
+        if (data.unchecked_at(pivot) == val) {
             return pivot; // found
-        } else if (data[pivot] < val) {
+        } else if (data.unchecked_at(pivot) < val) {
             left = pivot + 1; // search right
         } else {
             right = pivot - 1; // search left
@@ -93,52 +104,88 @@ int binarySearch(const Array<T> & data, const T & val) {
     return -1;
 }
 
-
-// PreCondition: Data array is full
+// PreCondition: Data array is full and sorted
 // PostCondition: return number of occurences of e in Array
-template <class T>
-int countOccurrence(const Array<T> & data, const T & e)
+template <class Seq, class T>
+int countOccurrenceOrderedOf(const Seq & data, const T & e)
 {
-	int count = 0, i;
-	for(i=0; i<data.length(); i++) {
-		if (data[i] == e) {
-            count++;
-        }
-	}
+	int i, count = 0;
+	// find first occurance
+	for (i = 0; i < data.length() && data.unchecked_at(i) != e; i++) {};
+	
+    // count contiguous occurances
+	for (; i < data.length() && data.unchecked_at(i) == e; i++, count++) {};
+
     #ifdef SEARCH_DEBUG_
-	std::cout << "\nCount Occurrence for " << e << " in " << data << " took " << (i+1) << " passes" << std::endl;
+	std::cout << "\nCount ordered Occurrence for " << e << " in " <<  data << " took " << (i+1) << " passes" << std::endl;
     #endif
 
 	return count;
 }
 
-// PreCondition: Data array is full and sorted
-// PostCondition: return number of occurences of e in Array
+// ---------------- Array and span overloads of each search ----------------
+// contiguous elements are tested for order and counted by the SIMD kernels
+
+template <class T, class Bounds>
+bool isOrdered(const Array<T, Bounds> & data) {
+	bool ordered = simdIsOrdered(data.data(), data.length());
+
+    #ifdef SEARCH_DEBUG_
+    std::cout << "\nisOrdered " <<  data << (ordered ? " is" : " is not") << " ordered" << std::endl;
+    #endif
+
+	return ordered;
+}
+template <class T>
+bool isOrdered(ArraySpan<T> data) { return simdIsOrdered(data.data(), data.length()); }
+template <class T>
+bool isOrdered(ReverseSpan<T> data) { return isOrderedOf(data); }
+
+template <class T, class Bounds>
+int sequentialSearch(const Array<T, Bounds> & data, const T & val) { return sequentialSearchOf(data, val); }
+template <class T>
+int sequentialSearch(ArraySpan<T> data, const typename ArraySpan<T>::value_type & val) { return sequentialSearchOf(data, val); }
 template <class T>
-int countOccurrenceOrdered(const Array<T> & data, const T & e)
+int sequentialSearch(ReverseSpan<T> data, const typename ReverseSpan<T>::value_type & val) { return sequentialSearchOf(data, val); }
+
+template <class T, class Bounds>
+int binarySearch(const Array<T, Bounds> & data, const T & val) { return binarySearchOf(data, val); }
+template <class T>
+int binarySearch(ArraySpan<T> data, const typename ArraySpan<T>::value_type & val) { return binarySearchOf(data, val); }
+template <class T>
+int binarySearch(ReverseSpan<T> data, const typename ReverseSpan<T>::value_type & val) { return binarySearchOf(data, val); }
+
+template <class T, class Bounds>
+int countOccurrence(const Array<T, Bounds> & data, const T & e)
 {
-	int i, count = 0;
-	// find first occurance
-	for (i = 0; i < data.length() && data[i] != e; i++) {};
-	
-    // count contiguous occurances
-	for (; i < data.length() && data[i] == e; i++, count++) {};
+	int count = simdCount(data.data(), data.length(), e);
 
     #ifdef SEARCH_DEBUG_
-	std::cout << "\nCount ordered Occurrence for " << e << " in " <<  data << " took " << (i+1) << " passes" << std::endl;
+	std::cout << "\nCount Occurrence for " << e << " in " << data << " took " << data.length() << " passes" << std::endl;
     #endif
 
 	return count;
 }
+template <class T>
+int countOccurrence(ArraySpan<T> data, const typename ArraySpan<T>::value_type & e) { return simdCount(data.data(), data.length(), e); }
+template <class T>
+int countOccurrence(ReverseSpan<T> data, const typename ReverseSpan<T>::value_type & e) { return countOccurrence(data.reverse(), e); }
+
+template <class T, class Bounds>
+int countOccurrenceOrdered(const Array<T, Bounds> & data, const T & e) { return countOccurrenceOrderedOf(data, e); }
+template <class T>
+int countOccurrenceOrdered(ArraySpan<T> data, const typename ArraySpan<T>::value_type & e) { return countOccurrenceOrderedOf(data, e); }
+template <class T>
+int countOccurrenceOrdered(ReverseSpan<T> data, const typename ReverseSpan<T>::value_type & e) { return countOccurrenceOrderedOf(data, e); }
 
 // PreCondition: data and keys are full arrays and are unordered
 // PostConditon: return true if elements in keys array is found 
 //               in data array, otherwise false  
-template <class T>
-bool containsAll(const Array<T> & data, const Array<T> & keys) {
+template <class T, class Bounds>
+bool containsAll(const Array<T, Bounds> & data, const Array<T, Bounds> & keys) {
     int i;
     for(i=0; i<keys.length(); i++) {
-        if (sequentialSearch(data, keys[i]) == -1) {
+        if (sequentialSearch(data, keys.unchecked_at(i)) == -1) {
             #ifdef SEARCH_DEBUG_
         	std::cout << "\ncontainsAll " << keys << " in " <<  data << " failed in " << (i+1) << " passes" << std::endl;
             #endif
@@ -155,8 +202,8 @@ bool containsAll(const Array<T> & data, const Array<T> & keys) {
 // PreCondition: named file exists and contains integers
 // PostCondition: array is loaded with integers read from
 //                file and array is resized if necessary
-template <class T>
-void loadFromFile(Array<T> & data, std::string fname) {
+template <class T, class Bounds>
+void loadFromFile(Array<T, Bounds> & data, std::string fname) {
 	std::ifstream ifile;
 	ifile.open(fname.c_str());
 
@@ -165,8 +212,8 @@ void loadFromFile(Array<T> & data, std::string fname) {
 		int i = 0;
 		while (ifile >> val) {
 			if (i == data.length())
-				data.resize(data.length() * 2); // double size of array
-			data[i++] = val;
+				data.resize(std::max(1, data.length() * 2)); // double size of array
+			data.unchecked_at(i++) = val;
 		}
 		// resize array to i, to remove unused blanks
 		data.resize(i);
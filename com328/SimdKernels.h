@@ -0,0 +1,352 @@
+/**
+ * SimdKernels.h
+ *
+ * Bulk kernels (fill, ordered test, sum, min, max, count) over contiguous
+ * elements. Generic versions are simple scalar loops; int versions use
+ * AVX2 or SSE4.1 when the CPU supports them, selected once at runtime
+ * using CPUID, with a portable scalar fallback.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.0
+ */
+
+#ifndef SIMDKERNELS_H_
+#define SIMDKERNELS_H_
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SIMD_X86_
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC allows any intrinsic in any function, gcc and clang need the target named
+#if defined(SIMD_X86_) && !defined(_MSC_VER)
+#define SIMD_TARGET_(t) __attribute__((target(t)))
+#else
+#define SIMD_TARGET_(t)
+#endif
+
+// Instruction set used by a set of kernels
+enum SimdLevel { SIMD_SCALAR, SIMD_SSE4, SIMD_AVX2 };
+
+// Type used to accumulate a sum of T - ints are summed in 64 bits
+template <class T> struct SumType { typedef T type; };
+template <> struct SumType<int> { typedef long long type; };
+
+// ============================ SCALAR KERNELS =============================================
+
+template <class T>
+void scalarFill(T *p, int n, const T & value) {
+	for (int i = 0; i < n; i++) {
+		p[i] = value;
+	}
+}
+
+template <class T>
+bool scalarIsOrdered(const T *p, int n) {
+	for (int i = 0; i < n - 1; i++) {
+		if (p[i] > p[i + 1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <class T>
+typename SumType<T>::type scalarSum(const T *p, int n) {
+	typename SumType<T>::type total = typename SumType<T>::type();
+	for (int i = 0; i < n; i++) {
+		total += p[i];
+	}
+	return total;
+}
+
+// PreCondition: n > 0
+template <class T>
+T scalarMin(const T *p, int n) {
+	T m = p[0];
+	for (int i = 1; i < n; i++) {
+		if (p[i] < m) { m = p[i]; }
+	}
+	return m;
+}
+
+// PreCondition: n > 0
+template <class T>
+T scalarMax(const T *p, int n) {
+	T m = p[0];
+	for (int i = 1; i < n; i++) {
+		if (p[i] > m) { m = p[i]; }
+	}
+	return m;
+}
+
+template <class T>
+int scalarCount(const T *p, int n, const T & value) {
+	int c = 0;
+	for (int i = 0; i < n; i++) {
+		if (p[i] == value) { c++; }
+	}
+	return c;
+}
+
+#ifdef SIMD_X86_
+// ============================ SSE4.1 KERNELS (int) =======================================
+
+SIMD_TARGET_("sse4.1")
+inline void sse4Fill(int *p, int n, const int & value) {
+	__m128i v = _mm_set1_epi32(value);
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), v);
+	}
+	for (; i < n; i++) { p[i] = value; }
+}
+
+SIMD_TARGET_("sse4.1")
+inline bool sse4IsOrdered(const int *p, int n) {
+	int i = 0;
+	// compare p[i..i+3] with p[i+1..i+4]
+	for (; i + 5 <= n; i += 4) {
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 1));
+		if (_mm_movemask_epi8(_mm_cmpgt_epi32(a, b)) != 0) {
+			return false;
+		}
+	}
+	return scalarIsOrdered(p + i, n - i);
+}
+
+SIMD_TARGET_("sse4.1")
+inline long long sse4Sum(const int *p, int n) {
+	__m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+		lo = _mm_add_epi64(lo, _mm_cvtepi32_epi64(v));
+		hi = _mm_add_epi64(hi, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+	}
+	long long lanes[2];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(lo, hi));
+	return lanes[0] + lanes[1] + scalarSum(p + i, n - i);
+}
+
+SIMD_TARGET_("sse4.1")
+inline int sse4Min(const int *p, int n) {
+	if (n < 4) { return scalarMin(p, n); }
+	__m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	int i = 4;
+	for (; i + 4 <= n; i += 4) {
+		m = _mm_min_epi32(m, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+	}
+	int lanes[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), m);
+	int r = scalarMin(lanes, 4);
+	return (i < n) ? (r < scalarMin(p + i, n - i) ? r : scalarMin(p + i, n - i)) : r;
+}
+
+SIMD_TARGET_("sse4.1")
+inline int sse4Max(const int *p, int n) {
+	if (n < 4) { return scalarMax(p, n); }
+	__m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	int i = 4;
+	for (; i + 4 <= n; i += 4) {
+		m = _mm_max_epi32(m, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+	}
+	int lanes[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), m);
+	int r = scalarMax(lanes, 4);
+	return (i < n) ? (r > scalarMax(p + i, n - i) ? r : scalarMax(p + i, n - i)) : r;
+}
+
+SIMD_TARGET_("sse4.1")
+inline int sse4Count(const int *p, int n, const int & value) {
+	__m128i v = _mm_set1_epi32(value), c = _mm_setzero_si128();
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
+		// equal lanes are -1, so subtracting the comparison counts matches
+		c = _mm_sub_epi32(c, _mm_cmpeq_epi32(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i))));
+	}
+	int lanes[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), c);
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalarCount(p + i, n - i, value);
+}
+
+// ============================ AVX2 KERNELS (int) =========================================
+
+SIMD_TARGET_("avx2")
+inline void avx2Fill(int *p, int n, const int & value) {
+	__m256i v = _mm256_set1_epi32(value);
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(p + i), v);
+	}
+	for (; i < n; i++) { p[i] = value; }
+}
+
+SIMD_TARGET_("avx2")
+inline bool avx2IsOrdered(const int *p, int n) {
+	int i = 0;
+	// compare p[i..i+7] with p[i+1..i+8]
+	for (; i + 9 <= n; i += 8) {
+		__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+		__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 1));
+		if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(a, b)) != 0) {
+			return false;
+		}
+	}
+	return scalarIsOrdered(p + i, n - i);
+}
+
+SIMD_TARGET_("avx2")
+inline long long avx2Sum(const int *p, int n) {
+	__m256i lo = _mm256_setzero_si256(), hi = _mm256_setzero_si256();
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+		lo = _mm256_add_epi64(lo, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+		hi = _mm256_add_epi64(hi, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+	}
+	long long lanes[4];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(lo, hi));
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalarSum(p + i, n - i);
+}
+
+SIMD_TARGET_("avx2")
+inline int avx2Min(const int *p, int n) {
+	if (n < 8) { return scalarMin(p, n); }
+	__m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	int i = 8;
+	for (; i + 8 <= n; i += 8) {
+		m = _mm256_min_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+	}
+	int lanes[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), m);
+	int r = scalarMin(lanes, 8);
+	return (i < n) ? (r < scalarMin(p + i, n - i) ? r : scalarMin(p + i, n - i)) : r;
+}
+
+SIMD_TARGET_("avx2")
+inline int avx2Max(const int *p, int n) {
+	if (n < 8) { return scalarMax(p, n); }
+	__m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	int i = 8;
+	for (; i + 8 <= n; i += 8) {
+		m = _mm256_max_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+	}
+	int lanes[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), m);
+	int r = scalarMax(lanes, 8);
+	return (i < n) ? (r > scalarMax(p + i, n - i) ? r : scalarMax(p + i, n - i)) : r;
+}
+
+SIMD_TARGET_("avx2")
+inline int avx2Count(const int *p, int n, const int & value) {
+	__m256i v = _mm256_set1_epi32(value), c = _mm256_setzero_si256();
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		c = _mm256_sub_epi32(c, _mm256_cmpeq_epi32(v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i))));
+	}
+	int lanes[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), c);
+	int total = 0;
+	for (int l = 0; l < 8; l++) { total += lanes[l]; }
+	return total + scalarCount(p + i, n - i, value);
+}
+#endif /* SIMD_X86_ */
+
+// ============================ RUNTIME DISPATCH ===========================================
+
+// Set of int kernels for one instruction set
+struct IntKernels {
+	SimdLevel level;
+	void      (*fill)(int *p, int n, const int & value);
+	bool      (*isOrdered)(const int *p, int n);
+	long long (*sum)(const int *p, int n);
+	int       (*min)(const int *p, int n);
+	int       (*max)(const int *p, int n);
+	int       (*count)(const int *p, int n, const int & value);
+};
+
+// PostCondition: returns the best instruction set supported by this CPU (and OS)
+inline SimdLevel detectSimdLevel() {
+#if defined(SIMD_X86_) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	int maxLeaf = info[0];
+	__cpuid(info, 1);
+	bool sse4 = (info[2] & (1 << 19)) != 0;
+	bool osAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+	bool avx2 = false;
+	if (maxLeaf >= 7 && osAvx) {
+		__cpuidex(info, 7, 0);
+		avx2 = (info[1] & (1 << 5)) != 0;
+	}
+	return avx2 ? SIMD_AVX2 : (sse4 ? SIMD_SSE4 : SIMD_SCALAR);
+#elif defined(SIMD_X86_)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) { return SIMD_AVX2; }
+	if (__builtin_cpu_supports("sse4.1")) { return SIMD_SSE4; }
+	return SIMD_SCALAR;
+#else
+	return SIMD_SCALAR;
+#endif
+}
+
+// PreCondition: level is supported by this CPU
+// PostCondition: returns the kernels for the specified instruction set
+inline IntKernels simdKernels(SimdLevel level) {
+#ifdef SIMD_X86_
+	if (level == SIMD_AVX2) {
+		IntKernels k = { SIMD_AVX2, avx2Fill, avx2IsOrdered, avx2Sum, avx2Min, avx2Max, avx2Count };
+		return k;
+	}
+	if (level == SIMD_SSE4) {
+		IntKernels k = { SIMD_SSE4, sse4Fill, sse4IsOrdered, sse4Sum, sse4Min, sse4Max, sse4Count };
+		return k;
+	}
+#endif
+	IntKernels k = { SIMD_SCALAR, scalarFill<int>, scalarIsOrdered<int>, scalarSum<int>,
+	                 scalarMin<int>, scalarMax<int>, scalarCount<int> };
+	return k;
+}
+
+// PostCondition: returns the kernels for this CPU, selected on first use
+inline const IntKernels & intKernels() {
+	static const IntKernels kernels = simdKernels(detectSimdLevel());
+	return kernels;
+}
+
+// ============================ PUBLIC INTERFACE ===========================================
+// The templates are used for any T, the int overloads dispatch to the selected kernels
+
+template <class T>
+void simdFill(T *p, int n, const T & value) { scalarFill(p, n, value); }
+inline void simdFill(int *p, int n, const int & value) { intKernels().fill(p, n, value); }
+
+template <class T>
+bool simdIsOrdered(const T *p, int n) { return scalarIsOrdered(p, n); }
+inline bool simdIsOrdered(const int *p, int n) { return intKernels().isOrdered(p, n); }
+
+template <class T>
+typename SumType<T>::type simdSum(const T *p, int n) { return scalarSum(p, n); }
+inline long long simdSum(const int *p, int n) { return intKernels().sum(p, n); }
+
+// PreCondition: n > 0
+template <class T>
+T simdMin(const T *p, int n) { return scalarMin(p, n); }
+inline int simdMin(const int *p, int n) { return intKernels().min(p, n); }
+
+// PreCondition: n > 0
+template <class T>
+T simdMax(const T *p, int n) { return scalarMax(p, n); }
+inline int simdMax(const int *p, int n) { return intKernels().max(p, n); }
+
+template <class T>
+int simdCount(const T *p, int n, const T & value) { return scalarCount(p, n, value); }
+inline int simdCount(const int *p, int n, const int & value) { return intKernels().count(p, n, value); }
+
+#endif /* SIMDKERNELS_H_ */
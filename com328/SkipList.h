@@ -0,0 +1,329 @@
+/***********************************************************************
+ * Name        : SkipList.h
+ * Author      : a.mccaughey@ulster.ac.uk
+ * Version     : 1.0
+ * Description : Indexable Skip List with the LinkedList interface. Nodes
+ *               are linked in position order on level 0 exactly as in a
+ *               LinkedList (so ListIterator traverses it), and on a random
+ *               number of higher levels whose links record how many
+ *               positions they span. get, set, add(pos) and remove(pos)
+ *               descend the levels, skipping whole spans, in O(log n)
+ *               expected time.
+ ***********************************************************************/
+
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "LinkedList.h"
+
+// =============================== SKIP NODE ==============================================
+// LinkedList Node with links on levels 1..height-1. Level 0 uses Node::next
+// and always spans one position
+template <class T>
+struct SkipNode : public Node<T> {
+	struct Link {
+		SkipNode<T>* next;
+		int span;
+	};
+
+	SkipNode(int height, const T & d = T()) : Node<T>(d), height(height), links(height > 1 ? new Link[height - 1] : nullptr) {
+		for (int l = 1; l < height; l++) {
+			links[l - 1].next = nullptr;
+			links[l - 1].span = 0;
+		}
+	}
+	~SkipNode() { delete[] links; }
+	SkipNode(const SkipNode &) = delete;
+	SkipNode & operator=(const SkipNode &) = delete;
+
+	SkipNode<T>* forward(int l) const	{ return l == 0 ? static_cast<SkipNode<T>*>(this->next) : links[l - 1].next; }
+	int span(int l) const				{ return l == 0 ? 1 : links[l - 1].span; }
+	void link(int l, SkipNode<T>* n, int s) {
+		if (l == 0) { this->next = n; } else { links[l - 1].next = n; links[l - 1].span = s; }
+	}
+
+	int   height;
+	Link *links;
+};
+
+// ============================== SKIP LIST ===========================================
+template <class T>
+class SkipList {
+public:
+	static const int MAX_LEVEL = 16;	// with 1 in 4 nodes promoted, ample for 4^16 elements
+
+	SkipList();
+	virtual ~SkipList();
+	SkipList(const SkipList<T> & other);
+	void operator=(const SkipList<T> & other);
+	bool operator==(const SkipList<T> & other) const;
+	bool operator!=(const SkipList<T> & other) const;
+
+	void clear();
+	void add(const T & value);
+	void add(int pos, const T & value);
+	void remove(int pos);
+	void set(int pos, const T & value);
+	T    get(int pos) const;
+	int  size() const;
+	bool isEmpty() const;
+
+	void print(std::ostream & os) const;
+	int  find(const T & value) const;
+
+	// Iterators - traverse level 0, as in a LinkedList
+	ListIterator<T> begin()			{ return ListIterator<T>(header->next); }
+	ListIterator<T> end()			{ return ListIterator<T>(nullptr); }
+	ListIterator<T> begin() const	{ return ListIterator<T>(header->next); }
+	ListIterator<T> end()   const	{ return ListIterator<T>(nullptr); }
+
+private:
+	SkipNode<T>* nodeAt(int pos) const;
+	void locate(int pos, SkipNode<T>** update, int* rank) const;
+	int  randomHeight();
+
+	SkipNode<T> *header;
+	int levels;			// levels in use, 1..MAX_LEVEL
+	int count;
+	unsigned seed;
+};
+
+// ============================== SkipList Implementation ======================
+
+// Default Constructor
+template <class T>
+SkipList<T>::SkipList() : header(new SkipNode<T>(MAX_LEVEL)), levels(1), count(0), seed(0x9E3779B9u) {}
+
+// Destructor
+template <class T>
+SkipList<T>::~SkipList() {
+	clear();
+	delete header;
+}
+
+// PostCondition: construct SkipList as a duplicate of other
+template <class T>
+SkipList<T>::SkipList(const SkipList<T> & other) : SkipList() {
+	for (ListIterator<T> itr = other.begin(); itr != other.end(); ++itr) {
+		add(*itr);
+	}
+}
+
+// PostCondition: assign other to SkipList
+template <class T>
+void SkipList<T>::operator=(const SkipList<T> & other) {
+	if (this != &other) {
+		clear();
+		for (ListIterator<T> itr = other.begin(); itr != other.end(); ++itr) {
+			add(*itr);
+		}
+	}
+}
+
+// PostCondition: test SkipLists for equality
+template <class T>
+bool SkipList<T>::operator==(const SkipList<T> & other) const {
+	bool same = size() == other.size();
+	for (ListIterator<T> itr = begin(), oitr = other.begin(); itr != end() && same; itr++, oitr++) {
+		if ((*itr) != (*oitr)) {
+			same = false;
+		}
+	}
+	return same;
+}
+
+template <class T>
+bool SkipList<T>::operator!=(const SkipList<T> & other) const {
+	return !operator==(other);
+}
+
+// PostCondition: return number of elements in SkipList
+template <class T>
+int SkipList<T>::size() const {
+	return count;
+}
+
+// PreCondition: pos is a valid insertion SkipList position
+// PostCondition: inserts element value at specified position in SkipList
+template <class T>
+void SkipList<T>::add(int pos, const T & value) {
+	if (pos < 0 || pos > size()) {
+		throw std::out_of_range("SkipList invalid position: " + std::to_string(pos));
+	}
+	SkipNode<T>* update[MAX_LEVEL];
+	int rank[MAX_LEVEL];
+	locate(pos, update, rank);
+
+	int h = randomHeight();
+	for (; levels < h; levels++) {		// new levels start at the header, spanning the whole list
+		update[levels] = header;
+		rank[levels] = -1;
+		header->link(levels, nullptr, count + 1);
+	}
+
+	SkipNode<T>* n = new SkipNode<T>(h, value);
+	for (int l = 0; l < h; l++) {
+		// n is at pos, the node update[l] linked to moves up one position
+		n->link(l, update[l]->forward(l), rank[l] + update[l]->span(l) + 1 - pos);
+		update[l]->link(l, n, pos - rank[l]);
+	}
+	for (int l = h; l < levels; l++) {	// links passing over n span one more position
+		update[l]->link(l, update[l]->forward(l), update[l]->span(l) + 1);
+	}
+	count++;
+}
+
+// PostCondition: inserts element value at end of SkipList
+template <class T>
+void SkipList<T>::add(const T & value) {
+	add(size(), value);
+}
+
+// PreCondition: pos is a valid SkipList position
+// PostCondition: deletes element at specified position in SkipList
+template <class T>
+void SkipList<T>::remove(int pos) {
+	if (pos < 0 || pos >= size()) {
+		throw std::out_of_range("SkipList invalid position: " + std::to_string(pos));
+	}
+	SkipNode<T>* update[MAX_LEVEL];
+	int rank[MAX_LEVEL];
+	locate(pos, update, rank);
+
+	SkipNode<T>* d = update[0]->forward(0);
+	for (int l = 0; l < levels; l++) {
+		if (update[l]->forward(l) == d) {
+			update[l]->link(l, d->forward(l), update[l]->span(l) + d->span(l) - 1);
+		} else {
+			update[l]->link(l, update[l]->forward(l), update[l]->span(l) - 1);
+		}
+	}
+	delete d;
+	while (levels > 1 && header->forward(levels - 1) == nullptr) {
+		levels--;
+	}
+	count--;
+}
+
+// PreCondition: pos is a valid SkipList position
+// PostCondition: returns element at specified position
+template <class T>
+T SkipList<T>::get(int pos) const {
+	if (pos < 0 || pos >= size()) {
+		throw std::out_of_range("SkipList invalid position: " + std::to_string(pos));
+	}
+	return nodeAt(pos)->data;
+}
+
+// PreCondition: pos is a valid SkipList position
+// PostCondition: updates element at specified position
+template <class T>
+void SkipList<T>::set(int pos, const T & value) {
+	if (pos < 0 || pos >= size()) {
+		throw std::out_of_range("SkipList invalid position: " + std::to_string(pos));
+	}
+	nodeAt(pos)->data = value;
+}
+
+// PostCondition: returns index of SkipList item if found or -1 if not found
+template <class T>
+int SkipList<T>::find(const T & value) const {
+	int i = 0;
+	for (ListIterator<T> itr = begin(); itr != end(); itr++, i++) {
+		if ((*itr) == value) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// PostCondition: prints contents of SkipList to output stream
+template <class T>
+void SkipList<T>::print(std::ostream & os) const {
+	os << "[ ";
+	for (ListIterator<T> itr = begin(); itr != end(); ++itr) {
+		os << (*itr) << " ";
+	}
+	os << "]";
+}
+
+// PreCondition:  pos is valid
+// PostCondition: returns node at specified position, header is position -1
+template <class T>
+SkipNode<T>* SkipList<T>::nodeAt(int pos) const {
+	SkipNode<T>* x = header;
+	int r = -1;
+	for (int l = levels - 1; l >= 0; l--) {
+		while (x->forward(l) != nullptr && r + x->span(l) <= pos) {
+			r += x->span(l);
+			x = x->forward(l);
+		}
+	}
+	return x;
+}
+
+// PreCondition:  0 <= pos <= size()
+// PostCondition: update[l] is the last node on level l before position pos and
+//                rank[l] its position, for each level in use
+template <class T>
+void SkipList<T>::locate(int pos, SkipNode<T>** update, int* rank) const {
+	SkipNode<T>* x = header;
+	int r = -1;
+	for (int l = levels - 1; l >= 0; l--) {
+		while (x->forward(l) != nullptr && r + x->span(l) < pos) {
+			r += x->span(l);
+			x = x->forward(l);
+		}
+		update[l] = x;
+		rank[l] = r;
+	}
+}
+
+// PostCondition: returns height of a new node, 1 with probability 3/4, 2 with 3/16 ...
+template <class T>
+int SkipList<T>::randomHeight() {
+	int h = 1;
+	for (;;) {
+		seed ^= seed << 13;		// xorshift32
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		if (h == MAX_LEVEL || (seed & 3) != 0) {
+			return h;
+		}
+		h++;
+	}
+}
+
+// PostCondition: SkipList is emptied count == 0
+template <class T>
+void SkipList<T>::clear() {
+	SkipNode<T>* n = header->forward(0);
+	while (n != nullptr) {
+		SkipNode<T>* d = n;
+		n = n->forward(0);
+		delete d;
+	}
+	for (int l = 0; l < MAX_LEVEL; l++) {
+		header->link(l, nullptr, 0);
+	}
+	levels = 1;
+	count = 0;
+}
+
+template <class T>
+bool SkipList<T>::isEmpty() const {
+	return (count == 0);
+}
+
+// PreCondition: None
+// PostCondition: overload << operator to output SkipList on ostream
+template <class T>
+std::ostream& operator <<(std::ostream& output, const SkipList<T>& l) {
+	l.print(output);
+	return output;
+}
+
+#endif /*SKIPLIST_H*/
@@ -0,0 +1,111 @@
+/**
+ * SmallArray.h
+ *
+ * Generic Dynamic Array with inline storage for up to N elements.
+ * Elements are only moved to the heap once the array grows beyond N,
+ * so small arrays are created and destroyed without any allocation.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.1
+ */
+
+#ifndef SMALLARRAY_H_
+#define SMALLARRAY_H_
+
+#include "Array.h"
+
+// Inline buffer for N elements of T. Held as a base class of SmallArray so
+// that it exists before the Array base class is handed its address.
+template <class T, int N>
+struct InlineSlots {
+	typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[N];
+
+	T* inlineSlots() { return reinterpret_cast<T*>(slots); }
+};
+
+template <class T, int N, class Bounds = CheckedBounds>
+class SmallArray : private InlineSlots<T, N>, public Array<T, Bounds>
+{
+public:
+	explicit SmallArray(int size=0);
+	~SmallArray();
+
+	SmallArray(const SmallArray & other);
+	SmallArray(const Array<T, Bounds> & other);
+	SmallArray(SmallArray && other) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+	SmallArray& operator=(const SmallArray & right);
+	SmallArray& operator=(SmallArray && right) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+	bool isInline() const;
+};
+
+// containers backed by a SmallArray start out in its inline buffer
+template <class T, int N, class Bounds>
+struct DefaultCapacity< SmallArray<T, N, Bounds> > {
+	static const int value = N;
+};
+
+// ========================= IMPLEMENTATION SmallArray.cpp ===================================
+
+// PreCondition: None
+// PostCondition: creates an array of specified size, held inline when size <= N
+template <class T, int N, class Bounds>
+SmallArray<T, N, Bounds>::SmallArray(int size)
+	: InlineSlots<T, N>(), Array<T, Bounds>(this->inlineSlots(), N, size) {}
+
+// PostCondition: elements destroyed while the inline buffer is still alive
+template <class T, int N, class Bounds>
+SmallArray<T, N, Bounds>::~SmallArray()
+{
+	this->release();
+}
+
+// PostCondition: copy of other, held inline when it fits
+template <class T, int N, class Bounds>
+SmallArray<T, N, Bounds>::SmallArray(const SmallArray<T, N, Bounds> & other)
+	: InlineSlots<T, N>(), Array<T, Bounds>(this->inlineSlots(), N, 0)
+{
+	Array<T, Bounds>::operator=(other);
+}
+
+// PostCondition: copy of other, held inline when it fits
+template <class T, int N, class Bounds>
+SmallArray<T, N, Bounds>::SmallArray(const Array<T, Bounds> & other)
+	: InlineSlots<T, N>(), Array<T, Bounds>(this->inlineSlots(), N, 0)
+{
+	Array<T, Bounds>::operator=(other);
+}
+
+// PostCondition: heap storage of other is taken over, inline elements are moved. Never
+//                allocates, as inline elements always fit the N or more slots of this
+template <class T, int N, class Bounds>
+SmallArray<T, N, Bounds>::SmallArray(SmallArray<T, N, Bounds> && other) noexcept(std::is_nothrow_move_constructible<T>::value)
+	: InlineSlots<T, N>(), Array<T, Bounds>(this->inlineSlots(), N, 0)
+{
+	Array<T, Bounds>::operator=(std::move(other));
+}
+
+template <class T, int N, class Bounds>
+SmallArray<T, N, Bounds> & SmallArray<T, N, Bounds>::operator=(const SmallArray<T, N, Bounds> & right)
+{
+	Array<T, Bounds>::operator=(right);
+	return *this;
+}
+
+template <class T, int N, class Bounds>
+SmallArray<T, N, Bounds> & SmallArray<T, N, Bounds>::operator=(SmallArray<T, N, Bounds> && right) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+	Array<T, Bounds>::operator=(std::move(right));
+	return *this;
+}
+
+// PostCondition: returns true if elements are held in the inline buffer
+template <class T, int N, class Bounds>
+bool SmallArray<T, N, Bounds>::isInline() const
+{
+	return this->isBorrowed();
+}
+
+#endif
@@ -0,0 +1,390 @@
+/**
+ * Snapshot.h
+ *
+ * Versioned, checksummed binary snapshot format used to save and restore
+ * library containers. A snapshot is a fixed header followed by a payload:
+ *
+ *   magic "C328SNAP" | version | byte order mark | payload bytes | CRC-32 of payload
+ *
+ * Containers write their state through a SnapshotWriter (writeTo) and read
+ * it back through a SnapshotReader (readFrom). Trivially copyable values are
+ * written and read as raw bytes, so an array of them is a single bulk I/O
+ * call straight into its storage. The reader checks the payload length
+ * against the stream, and every count against the bytes left, before it is
+ * acted on; the checksum runs over the stream and is checked by finish(), so
+ * readFrom must fill a copy that is kept only once finish() succeeds, as
+ * loadSnapshot does. Other value types need writeValue/readValue overloads,
+ * as provided here for std::string.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.2
+ */
+
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+const char          SNAPSHOT_MAGIC[8] = { 'C', '3', '2', '8', 'S', 'N', 'A', 'P' };
+const std::uint32_t SNAPSHOT_VERSION = 1;
+const std::uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+// PostCondition: returns CRC-32 (IEEE) of n bytes at p, continuing from crc
+inline std::uint32_t crc32(std::uint32_t crc, const void *p, size_t n) {
+	struct Table {
+		std::uint32_t entry[256];
+		Table() {
+			for (std::uint32_t i = 0; i < 256; i++) {
+				std::uint32_t c = i;
+				for (int k = 0; k < 8; k++) {
+					c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+				}
+				entry[i] = c;
+			}
+		}
+	};
+	static const Table table;
+
+	const unsigned char *bytes = static_cast<const unsigned char*>(p);
+	crc = ~crc;
+	for (size_t i = 0; i < n; i++) {
+		crc = table.entry[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+// ============================ WRITER =====================================================
+
+class SnapshotWriter {
+public:
+	explicit SnapshotWriter(std::ostream & out);
+
+	void write(const void *p, size_t bytes);
+	void writeTag(const char tag[4]);
+	void writeCount(int n);
+	void finish();
+
+private:
+	std::ostream & out;
+	std::streampos start;
+	std::uint64_t  length;
+	std::uint32_t  crc;
+};
+
+// PreCondition: out is a seekable binary stream
+// PostCondition: header written, with length and checksum patched by finish()
+inline SnapshotWriter::SnapshotWriter(std::ostream & out) : out(out), start(out.tellp()), length(0), crc(0)
+{
+	std::uint64_t noLength = 0;
+	std::uint32_t noCrc = 0;
+	out.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	out.write(reinterpret_cast<const char*>(&SNAPSHOT_VERSION), sizeof(SNAPSHOT_VERSION));
+	out.write(reinterpret_cast<const char*>(&SNAPSHOT_BYTE_ORDER), sizeof(SNAPSHOT_BYTE_ORDER));
+	out.write(reinterpret_cast<const char*>(&noLength), sizeof(noLength));
+	out.write(reinterpret_cast<const char*>(&noCrc), sizeof(noCrc));
+}
+
+// PostCondition: bytes appended to the payload, throws runtime_error if the stream fails
+inline void SnapshotWriter::write(const void *p, size_t bytes)
+{
+	if (bytes > 0) {
+		out.write(static_cast<const char*>(p), (std::streamsize)bytes);
+		crc = crc32(crc, p, bytes);
+		length += bytes;
+	}
+	if (out.fail()) {
+		throw std::runtime_error("Snapshot: write failed");
+	}
+}
+
+// PostCondition: four character tag identifying the next container written
+inline void SnapshotWriter::writeTag(const char tag[4])
+{
+	write(tag, 4);
+}
+
+inline void SnapshotWriter::writeCount(int n)
+{
+	std::int32_t count = n;
+	write(&count, sizeof(count));
+}
+
+// PostCondition: payload length and checksum are written into the header
+inline void SnapshotWriter::finish()
+{
+	std::streampos end = out.tellp();
+	out.seekp(start + std::streamoff(sizeof(SNAPSHOT_MAGIC) + 2 * sizeof(std::uint32_t)));
+	out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+	out.write(reinterpret_cast<const char*>(&crc), sizeof(crc));
+	out.seekp(end);
+	if (out.fail()) {
+		throw std::runtime_error("Snapshot: write failed");
+	}
+}
+
+// ============================ READER =====================================================
+
+class SnapshotReader {
+public:
+	explicit SnapshotReader(std::istream & in);
+
+	void read(void *p, size_t bytes);
+	void readTag(const char tag[4]);
+	int  readCount();
+	std::uint64_t remaining() const;
+	void finish();
+
+private:
+	std::istream & in;
+	std::uint64_t  length;
+	std::uint64_t  consumed;
+	std::uint32_t  crc;
+	std::uint32_t  expectedCrc;
+};
+
+// PostCondition: header read and validated, throws runtime_error if the stream is not
+//                a snapshot of this version and byte order, or a seekable stream is
+//                shorter than the payload length the header gives
+inline SnapshotReader::SnapshotReader(std::istream & in) : in(in), length(0), consumed(0), crc(0), expectedCrc(0)
+{
+	char magic[sizeof(SNAPSHOT_MAGIC)];
+	std::uint32_t version = 0, order = 0;
+	in.read(magic, sizeof(magic));
+	in.read(reinterpret_cast<char*>(&version), sizeof(version));
+	in.read(reinterpret_cast<char*>(&order), sizeof(order));
+	in.read(reinterpret_cast<char*>(&length), sizeof(length));
+	in.read(reinterpret_cast<char*>(&expectedCrc), sizeof(expectedCrc));
+	if (in.fail() || std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0) {
+		throw std::runtime_error("Snapshot: not a snapshot");
+	}
+	if (version != SNAPSHOT_VERSION) {
+		throw std::runtime_error("Snapshot: unsupported version " + std::to_string(version));
+	}
+	if (order != SNAPSHOT_BYTE_ORDER) {
+		throw std::runtime_error("Snapshot: written with a different byte order");
+	}
+
+	// counts are bounded by remaining(), so make sure the bytes are really there
+	std::streampos at = in.tellg();
+	if (at != std::streampos(-1)) {
+		in.seekg(0, std::ios::end);
+		std::streampos end = in.tellg();
+		in.seekg(at);
+		if (end != std::streampos(-1) && (std::uint64_t)(end - at) < length) {
+			throw std::runtime_error("Snapshot: truncated");
+		}
+	}
+}
+
+// PostCondition: next bytes of the payload read into p, throws runtime_error
+//                if the payload is shorter than expected
+inline void SnapshotReader::read(void *p, size_t bytes)
+{
+	if (bytes > remaining()) {
+		throw std::runtime_error("Snapshot: truncated");
+	}
+	if (bytes > 0) {
+		in.read(static_cast<char*>(p), (std::streamsize)bytes);
+		if (in.fail()) {
+			throw std::runtime_error("Snapshot: truncated");
+		}
+		crc = crc32(crc, p, bytes);
+		consumed += bytes;
+	}
+}
+
+// PostCondition: throws runtime_error unless the next container has the specified tag
+inline void SnapshotReader::readTag(const char tag[4])
+{
+	char found[4];
+	read(found, 4);
+	if (std::memcmp(found, tag, 4) != 0) {
+		throw std::runtime_error("Snapshot: expected " + std::string(tag, 4) + " found " + std::string(found, 4));
+	}
+}
+
+// PostCondition: returns count, throws runtime_error if it could not fit in the payload
+inline int SnapshotReader::readCount()
+{
+	std::int32_t count;
+	read(&count, sizeof(count));
+	if (count < 0 || (std::uint64_t)count > remaining()) {
+		throw std::runtime_error("Snapshot: corrupt count " + std::to_string(count));
+	}
+	return count;
+}
+
+// PostCondition: returns number of payload bytes not yet read
+inline std::uint64_t SnapshotReader::remaining() const
+{
+	return length - consumed;
+}
+
+// PostCondition: throws runtime_error unless the whole payload was read and
+//                matches its checksum
+inline void SnapshotReader::finish()
+{
+	if (remaining() != 0) {
+		throw std::runtime_error("Snapshot: payload not fully read");
+	}
+	if (crc != expectedCrc) {
+		throw std::runtime_error("Snapshot: checksum mismatch");
+	}
+}
+
+// ============================ VALUES =====================================================
+
+inline void writeValue(SnapshotWriter & w, const std::string & s)
+{
+	w.writeCount((int)s.length());
+	w.write(s.data(), s.length());
+}
+
+inline void readValue(SnapshotReader & r, std::string & s)
+{
+	s.resize(r.readCount());
+	if (!s.empty()) {
+		r.read(&s[0], s.length());
+	}
+}
+
+template <class T>
+void writeValue(SnapshotWriter & w, const T & v, std::true_type)
+{
+	w.write(&v, sizeof(T));
+}
+
+template <class T>
+void writeValue(SnapshotWriter & w, const T & v, std::false_type)
+{
+	static_assert(sizeof(T) == 0, "Snapshot: provide writeValue/readValue for this type");
+}
+
+template <class T>
+void readValue(SnapshotReader & r, T & v, std::true_type)
+{
+	r.read(&v, sizeof(T));
+}
+
+template <class T>
+void readValue(SnapshotReader & r, T & v, std::false_type)
+{
+	static_assert(sizeof(T) == 0, "Snapshot: provide writeValue/readValue for this type");
+}
+
+// PostCondition: v written as raw bytes when trivially copyable
+template <class T>
+void writeValue(SnapshotWriter & w, const T & v)
+{
+	writeValue(w, v, std::is_trivially_copyable<T>());
+}
+
+template <class T>
+void readValue(SnapshotReader & r, T & v)
+{
+	readValue(r, v, std::is_trivially_copyable<T>());
+}
+
+// PostCondition: n values at p written, trivially copyable values with one bulk write
+//                preceded by their size so a mismatched element type is detected
+template <class T>
+void writeValues(SnapshotWriter & w, const T *p, int n, std::true_type)
+{
+	std::uint32_t size = sizeof(T);
+	w.write(&size, sizeof(size));
+	w.write(p, sizeof(T) * n);
+}
+
+template <class T>
+void writeValues(SnapshotWriter & w, const T *p, int n, std::false_type)
+{
+	for (int i = 0; i < n; i++) {
+		writeValue(w, p[i]);
+	}
+}
+
+template <class T>
+void readValues(SnapshotReader & r, T *p, int n, std::true_type)
+{
+	std::uint32_t size;
+	r.read(&size, sizeof(size));
+	if (size != sizeof(T)) {
+		throw std::runtime_error("Snapshot: element size mismatch");
+	}
+	r.read(p, sizeof(T) * n);
+}
+
+template <class T>
+void readValues(SnapshotReader & r, T *p, int n, std::false_type)
+{
+	for (int i = 0; i < n; i++) {
+		readValue(r, p[i]);
+	}
+}
+
+template <class T>
+void writeValues(SnapshotWriter & w, const T *p, int n)
+{
+	writeValues(w, p, n, std::is_trivially_copyable<T>());
+}
+
+// PreCondition: p refers to n constructed elements
+template <class T>
+void readValues(SnapshotReader & r, T *p, int n)
+{
+	readValues(r, p, n, std::is_trivially_copyable<T>());
+}
+
+// ============================ CONTAINERS =================================================
+// Any container providing writeTo(SnapshotWriter&) and readFrom(SnapshotReader&)
+
+// PostCondition: snapshot of container written to out
+template <class Container>
+void saveSnapshot(const Container & c, std::ostream & out)
+{
+	SnapshotWriter w(out);
+	c.writeTo(w);
+	w.finish();
+}
+
+// PostCondition: container replaced by the snapshot read from in. The container
+//                is unchanged if the snapshot is invalid (runtime_error is thrown)
+template <class Container>
+void loadSnapshot(Container & c, std::istream & in)
+{
+	SnapshotReader r(in);
+	Container tmp;
+	tmp.readFrom(r);
+	r.finish();
+	c = std::move(tmp);
+}
+
+template <class Container>
+void saveSnapshot(const Container & c, const std::string & fname)
+{
+	std::ofstream out(fname.c_str(), std::ios::binary | std::ios::trunc);
+	if (out.fail()) {
+		throw std::runtime_error("Snapshot: cannot create " + fname);
+	}
+	saveSnapshot(c, out);
+}
+
+template <class Container>
+void loadSnapshot(Container & c, const std::string & fname)
+{
+	std::ifstream in(fname.c_str(), std::ios::binary);
+	if (in.fail()) {
+		throw std::runtime_error("Snapshot: cannot open " + fname);
+	}
+	loadSnapshot(c, in);
+}
+
+#endif
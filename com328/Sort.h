@@ -5,7 +5,7 @@
  *
  * @author  Aiden McCaughey
  * @email   a.mccaughey@ulster.ac.uk
- * @version 2.0
+ * @version 2.1
  */
 
 #ifndef SORT_H_
@@ -15,6 +15,14 @@
 //#define SORT_DEBUG_
 
 #include "Array.h"
+#include "ArraySpan.h"
+
+// every index used below is derived from length() so elements are accessed
+// with unchecked_at, whatever Bounds policy the Array was declared with
+
+// Each sort accepts an Array, an ArraySpan or a ReverseSpan, so a subrange can be
+// sorted in place, e.g. quickSort(list.drop(2)). The algorithms themselves are the
+// ...Of templates, written against any Seq providing length() and unchecked_at().
 
 //  swap algorithm to swap two elements
 template <class T>
@@ -25,21 +33,21 @@ void swap(T& a, T& b) {
 }
 
 // PostCondition: collection elements are sorted
-template <class T>
-void selectionSort(Array<T> & elements) {
+template <class T, class Seq>
+void selectionSortOf(Seq & elements) {
     int min, moves = 0, comps = 0;
 
     for (int marker = 0; marker < elements.length() - 1; marker++) {
         min = marker;
         for (int i = marker + 1; i < elements.length(); i++) {
             comps++;
-			if (elements[i] < elements[min]) {
+			if (elements.unchecked_at(i) < elements.unchecked_at(min)) {
 				min = i;
 			}
         }
         // swap elements at position min and out
         moves += 3;
-        swap<T>(elements[marker], elements[min]);
+        swap<T>(elements.unchecked_at(marker), elements.unchecked_at(min));
 
         #ifdef SORT_DEBUG_
         std::cout << "End of Pass " << (marker+1) << " " << elements << std::endl;
@@ -52,17 +60,17 @@ void selectionSort(Array<T> & elements) {
 }
 
 // PostCondition: collection elements are sorted
-template <class T>
-void bubbleSort(Array<T> & elements) {
+template <class T, class Seq>
+void bubbleSortOf(Seq & elements) {
     int moves =0, comps = 0;
     
     for (int i = 0 ; i < elements.length(); i++) {
         for (int e = 0 ; e < elements.length() - i - 1; e++) {
             comps++;
             // swap elements at positions e and e+1. For decreasing order use < */ 
-            if (elements[e] > elements[e+1]) { 
+            if (elements.unchecked_at(e) > elements.unchecked_at(e+1)) { 
                 moves += 3;
-                swap<T>(elements[e], elements[e+1]);
+                swap<T>(elements.unchecked_at(e), elements.unchecked_at(e+1));
             }
         }
         #ifdef SORT_DEBUG_
@@ -76,21 +84,22 @@ void bubbleSort(Array<T> & elements) {
 }
 
 // PostCondition: collection elements are sorted
-template <class T>
-void insertionSort(Array<T> & elements) {
+template <class T, class Seq>
+void insertionSortOf(Seq & elements) {
     int comps = 0, moves = 0;
-    int in, out, temp;
+    int in, out;
+    T temp;
     for (out = 1; out < elements.length(); out++) {
-        temp = elements[out];
+        temp = elements.unchecked_at(out);
         moves++;
         // find position for temp
-        for (in = out; in > 0 && elements[in - 1] >= temp; in--) {
-            elements[in] = elements[in - 1];
+        for (in = out; in > 0 && elements.unchecked_at(in - 1) >= temp; in--) {
+            elements.unchecked_at(in) = elements.unchecked_at(in - 1);
             comps++;
             moves++; // one comp and one move on each iteration
         }
         comps++; // final comp which terminates loop above
-        elements[in] = temp;
+        elements.unchecked_at(in) = temp;
         moves++; // additional move
      
         #ifdef SORT_DEBUG_
@@ -106,8 +115,8 @@ void insertionSort(Array<T> & elements) {
 
 // PostCondition: elements sorted using merge sort algorithm
 
-template <class T>
-void mergeSort(Array<T> & elements) {
+template <class T, class Seq>
+void mergeSortOf(Seq & elements) {
     Array<T> work(elements.length());
 
     divide(work, elements, 0, elements.length() - 1);
@@ -115,8 +124,8 @@ void mergeSort(Array<T> & elements) {
 
 // Private merge sort divide algorithm
 
-template <class T>
-void divide(Array<T> & work, Array<T> & data, int left, int right) {
+template <class T, class Seq>
+void divide(Array<T> & work, Seq & data, int left, int right) {
     if (left < right) {
         int center = (left + right) / 2;
         divide(work, data, left, center);
@@ -127,8 +136,8 @@ void divide(Array<T> & work, Array<T> & data, int left, int right) {
 
 // Private merge sort merge algorithm
 
-template <class T>
-void merge(Array<T> & work, Array<T> & data,
+template <class T, class Seq>
+void merge(Array<T> & work, Seq & data,
         int leftS, int rightS, int rightE) {
     int leftE = rightS - 1;
     int tmpPos = leftS;
@@ -136,41 +145,20 @@ void merge(Array<T> & work, Array<T> & data,
 
     // Main loop
     while (leftS <= leftE && rightS <= rightE) {
-        if (data[ leftS ] < data[ rightS ])
-            work[ tmpPos++ ] = data[ leftS++ ];
+        if (data.unchecked_at(leftS) < data.unchecked_at(rightS))
+            work.unchecked_at(tmpPos++) = data.unchecked_at(leftS++);
         else
-            work[ tmpPos++ ] = data[ rightS++ ];
+            work.unchecked_at(tmpPos++) = data.unchecked_at(rightS++);
     }
     while (leftS <= leftE) // Copy rest of left half
-        work[ tmpPos++ ] = data[ leftS++ ];
+        work.unchecked_at(tmpPos++) = data.unchecked_at(leftS++);
 
     while (rightS <= rightE) // Copy rest of right half
-        work[ tmpPos++ ] = data[ rightS++ ];
+        work.unchecked_at(tmpPos++) = data.unchecked_at(rightS++);
 
     // Copy work back into data
     for (int i = 0; i < numElements; i++, rightE--)
-        data[ rightE ] = work[ rightE ];
-}
-
-
-// PostCondition: elements sorted using quicksort
-
-template <class T>
-void quickSort(Array<T> & elements) {
-    qsort(elements, 0, elements.length() - 1);
-}
-
-// Private quicksort sorter method
-
-template <class T>
-void qsort(Array<T> & data, int low, int high) {
-    int s; // Pivot location
-
-    if (low < high) {
-        s = qpartition(data, low, high);
-        qsort(data, low, s - 1);
-        qsort(data, s + 1, high);
-    }
+        data.unchecked_at(rightE) = work.unchecked_at(rightE);
 }
 
 
@@ -178,25 +166,85 @@ void qsort(Array<T> & data, int low, int high) {
 // [low..high] so that: elements smaller than pivot are placed before
 // it and elements greater than pivot are placed after it.
 
-template <class T>
-int qpartition(Array<T> & data, int low, int high) {
+template <class T, class Seq>
+int qpartition(Seq & data, int low, int high) {
     int s; // start of sub-list (elements > pivot)
     int m; // index into array
     T pivot; // pivot value
 
     // pivot selected as first element in array positions low..high
-    pivot = data[low];
+    pivot = data.unchecked_at(low);
     s = low;
 
     for (m = s + 1; m <= high; m++) {
-        if (data[m] < pivot) {
-            swap<T>(data[++s], data[m]);
+        if (data.unchecked_at(m) < pivot) {
+            swap<T>(data.unchecked_at(++s), data.unchecked_at(m));
         }
     }
     // put pivot in correct position
-    swap<T>(data[low], data[s]);
+    swap<T>(data.unchecked_at(low), data.unchecked_at(s));
     return s;
 }
 
+
+// Private quicksort sorter method
+
+template <class T, class Seq>
+void qsort(Seq & data, int low, int high) {
+    int s; // Pivot location
+
+    if (low < high) {
+        s = qpartition<T>(data, low, high);
+        qsort<T>(data, low, s - 1);
+        qsort<T>(data, s + 1, high);
+    }
+}
+
+
+// PostCondition: elements sorted using quicksort
+
+template <class T, class Seq>
+void quickSortOf(Seq & elements) {
+    qsort<T>(elements, 0, elements.length() - 1);
+}
+
+
+// ---------------- Array and span overloads of each sort ----------------
+
+template <class T, class Bounds>
+void selectionSort(Array<T, Bounds> & elements) { selectionSortOf<T>(elements); }
+template <class T>
+void selectionSort(ArraySpan<T> elements) { selectionSortOf<T>(elements); }
+template <class T>
+void selectionSort(ReverseSpan<T> elements) { selectionSortOf<T>(elements); }
+
+template <class T, class Bounds>
+void bubbleSort(Array<T, Bounds> & elements) { bubbleSortOf<T>(elements); }
+template <class T>
+void bubbleSort(ArraySpan<T> elements) { bubbleSortOf<T>(elements); }
+template <class T>
+void bubbleSort(ReverseSpan<T> elements) { bubbleSortOf<T>(elements); }
+
+template <class T, class Bounds>
+void insertionSort(Array<T, Bounds> & elements) { insertionSortOf<T>(elements); }
+template <class T>
+void insertionSort(ArraySpan<T> elements) { insertionSortOf<T>(elements); }
+template <class T>
+void insertionSort(ReverseSpan<T> elements) { insertionSortOf<T>(elements); }
+
+template <class T, class Bounds>
+void mergeSort(Array<T, Bounds> & elements) { mergeSortOf<T>(elements); }
+template <class T>
+void mergeSort(ArraySpan<T> elements) { mergeSortOf<T>(elements); }
+template <class T>
+void mergeSort(ReverseSpan<T> elements) { mergeSortOf<T>(elements); }
+
+template <class T, class Bounds>
+void quickSort(Array<T, Bounds> & elements) { quickSortOf<T>(elements); }
+template <class T>
+void quickSort(ArraySpan<T> elements) { quickSortOf<T>(elements); }
+template <class T>
+void quickSort(ReverseSpan<T> elements) { quickSortOf<T>(elements); }
+
 #endif	/* SORT_H */
 
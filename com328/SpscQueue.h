@@ -0,0 +1,221 @@
+/**
+ * SpscQueue.h
+ *
+ * Lock free Queue for handing elements from one producer thread to one
+ * consumer thread, with the semantics of the fixed capacity ArrayQueue.
+ * The producer only writes tail and the consumer only writes head, each
+ * on a cache line of its own, published with release stores and read
+ * with acquire loads. Each thread keeps the last value it read of the
+ * other's index and only reloads it when the queue looks full (or empty),
+ * so in steady state neither touches the other's cache line. enqueueN and
+ * dequeueN move a batch and publish it with a single store.
+ *
+ * enqueue, tryEnqueue and enqueueN may only be called by the producer,
+ * peek, dequeue, tryDequeue, dequeueN and clear only by the consumer.
+ *
+ * @author  Aiden McCaughey
+ * @email   a.mccaughey@ulster.ac.uk
+ * @version 1.1
+ */
+
+#ifndef SPSCQUEUE_H_
+#define SPSCQUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include "AlignedArray.h"
+
+template <class T>
+class SpscQueue {
+public:
+	explicit SpscQueue(int n=100);
+	SpscQueue(const SpscQueue &) = delete;
+	SpscQueue & operator=(const SpscQueue &) = delete;
+
+	// producer
+	void enqueue(const T & x);
+	bool tryEnqueue(const T & x);
+	int  enqueueN(const T * items, int n);
+
+	// consumer
+	const T & peek() const;
+	void dequeue();
+	bool tryDequeue(T & x);
+	int  dequeueN(T * items, int n);
+	void clear();
+
+	// either thread - a snapshot that may be out of date when used
+	bool isEmpty() const;
+	int  size() const;
+	int  capacity() const;
+
+private:
+	static int ringSize(int n);
+	int  room(int wanted);
+	int  available(int wanted) const;
+
+	// indexes count every element ever enqueued and wrap as unsigned values, the
+	// slot of index i is i & mask
+	AlignedArray<T, UncheckedBounds> data;	// length is a power of two
+	unsigned mask;
+	int  limit;								// most elements held
+
+	// each thread's index on a cache line of its own, the queue rounded up to whole lines
+	alignas(CACHE_LINE) std::atomic<unsigned> head;		// next to dequeue, written by the consumer
+	mutable unsigned tailSeen;				// consumer's last reading of tail
+
+	alignas(CACHE_LINE) std::atomic<unsigned> tail;		// next free slot, written by the producer
+	unsigned headSeen;						// producer's last reading of head
+};
+
+// ========================= IMPLEMENTATION SpscQueue.cpp ===================================
+
+// PostCondition: empty queue of capacity n, with a ring buffer of the power of two >= n
+template <class T>
+SpscQueue<T>::SpscQueue(int n)
+	: data(ringSize(n)), mask(ringSize(n) - 1), limit{ std::max(n, 1) }, head{ 0 }, tailSeen{ 0 }, tail{ 0 }, headSeen{ 0 } {}
+
+// PostCondition: returns smallest power of two >= n
+template <class T>
+int SpscQueue<T>::ringSize(int n) {
+	int slots = 1;
+	while (slots < n) {
+		slots *= 2;
+	}
+	return slots;
+}
+
+// PostCondition: returns number of free slots the producer can fill, rereading head
+//                only when the last reading leaves fewer than wanted
+template <class T>
+int SpscQueue<T>::room(int wanted) {
+	unsigned t = tail.load(std::memory_order_relaxed);
+	if (limit - (int)(t - headSeen) < wanted) {
+		headSeen = head.load(std::memory_order_acquire);
+	}
+	return limit - (int)(t - headSeen);
+}
+
+// PostCondition: returns number of elements the consumer can take, rereading tail
+//                only when the last reading leaves fewer than wanted
+template <class T>
+int SpscQueue<T>::available(int wanted) const {
+	unsigned h = head.load(std::memory_order_relaxed);
+	if ((int)(tailSeen - h) < wanted) {
+		tailSeen = tail.load(std::memory_order_acquire);
+	}
+	return (int)(tailSeen - h);
+}
+
+// PostCondition: x added to end of the queue and true returned, or false if full
+template <class T>
+bool SpscQueue<T>::tryEnqueue(const T & x) {
+	if (room(1) == 0) {
+		return false;
+	}
+	unsigned t = tail.load(std::memory_order_relaxed);
+	data.unchecked_at(t & mask) = x;
+	tail.store(t + 1, std::memory_order_release);
+	return true;
+}
+
+// PreCondition: the queue is not full
+// PostCondition: element is added to end of the queue
+template <class T>
+void SpscQueue<T>::enqueue(const T & x) {
+	if (!tryEnqueue(x)) {
+		throw std::overflow_error("queue overflow");
+	}
+}
+
+// PostCondition: as many of items[0..n-1] as fit added in order, in at most two
+//                contiguous copies, published together. Returns the number added
+template <class T>
+int SpscQueue<T>::enqueueN(const T * items, int n) {
+	n = std::max(0, std::min(n, room(n)));
+	unsigned t = tail.load(std::memory_order_relaxed);
+	int back = (int)(t & mask);
+	int first = std::min(n, data.length() - back);	// up to the end of the buffer
+	std::copy(items, items + first, data.data() + back);
+	std::copy(items + first, items + n, data.data());
+	tail.store(t + n, std::memory_order_release);
+	return n;
+}
+
+// PreCondition: the queue is not empty
+// PostCondition: return the least recently inserted item, valid until it is dequeued
+template <class T>
+const T & SpscQueue<T>::peek() const {
+	if (available(1) == 0) {
+		throw std::underflow_error("queue underflow");
+	}
+	return data.unchecked_at(head.load(std::memory_order_relaxed) & mask);
+}
+
+// PreCondition: the queue is not empty
+// PostCondition: remove the least recently inserted item in the queue.
+template <class T>
+void SpscQueue<T>::dequeue() {
+	if (available(1) == 0) {
+		throw std::underflow_error("queue underflow");
+	}
+	head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// PostCondition: least recently inserted item moved to x, removed and true returned,
+//                or false if empty
+template <class T>
+bool SpscQueue<T>::tryDequeue(T & x) {
+	if (available(1) == 0) {
+		return false;
+	}
+	unsigned h = head.load(std::memory_order_relaxed);
+	x = std::move(data.unchecked_at(h & mask));
+	head.store(h + 1, std::memory_order_release);
+	return true;
+}
+
+// PostCondition: up to n least recently inserted items moved to items[0..] in order, in
+//                at most two contiguous copies, and removed together. Returns the number
+template <class T>
+int SpscQueue<T>::dequeueN(T * items, int n) {
+	n = std::max(0, std::min(n, available(n)));
+	unsigned h = head.load(std::memory_order_relaxed);
+	int front = (int)(h & mask);
+	int first = std::min(n, data.length() - front);	// up to the end of the buffer
+	std::move(data.data() + front, data.data() + front + first, items);
+	std::move(data.data(), data.data() + n - first, items + first);
+	head.store(h + n, std::memory_order_release);
+	return n;
+}
+
+// PostCondition: elements enqueued so far are removed
+template <class T>
+void SpscQueue<T>::clear() {
+	tailSeen = tail.load(std::memory_order_acquire);
+	head.store(tailSeen, std::memory_order_release);
+}
+
+// PostCondition: return number of elements in the queue, head is read first so the
+//                difference is never negative
+template <class T>
+int SpscQueue<T>::size() const {
+	unsigned h = head.load(std::memory_order_acquire);
+	unsigned t = tail.load(std::memory_order_acquire);
+	return std::min((int)(t - h), limit);
+}
+
+template <class T>
+bool SpscQueue<T>::isEmpty() const {
+	return size() == 0;
+}
+
+template <class T>
+int SpscQueue<T>::capacity() const {
+	return limit;
+}
+
+#endif
@@ -0,0 +1,339 @@
+/***********************************************************************
+ * Name        : UnrolledList.h
+ * Author      : a.mccaughey@ulster.ac.uk
+ * Version     : 1.0
+ * Description : Unrolled Linked List class with the LinkedList interface.
+ *               Each node holds a block of up to B contiguous elements, so
+ *               positional operations skip a whole block per step and a
+ *               traversal touches one node per B elements. Middle inserts
+ *               shift within a block only, splitting it when full.
+ ***********************************************************************/
+
+#ifndef UNROLLEDLIST_H
+#define UNROLLEDLIST_H
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "NodePool.h"
+
+// =============================== LIST BLOCK =============================================
+// Block of up to B elements, items[0..count-1] are in use
+template <class T, int B>
+struct UnrolledBlock {
+	UnrolledBlock(UnrolledBlock<T, B>* n = nullptr) : count(0), next(n) { }
+
+	T items[B];
+	int count;
+	UnrolledBlock<T, B>* next;
+};
+
+// ============================= LIST ITERATOR ============================================
+// Iterator Class, steps through the elements of a block before moving to the next block
+template <class T, int B>
+class UnrolledIterator {
+	public:
+		UnrolledIterator(UnrolledBlock<T, B> *start=nullptr, int index=0) : block(start), index(index) {}
+		T & operator*()										{ return block->items[index]; }
+		UnrolledIterator & operator++()						{ if (++index == block->count) { block = block->next; index = 0; } return *(this); }
+		UnrolledIterator operator++(int)					{ UnrolledIterator tmp(*this); ++(*this); return tmp; }
+
+		bool operator!=(const UnrolledIterator & o)	const	{ return block != o.block || index != o.index; }
+		bool operator==(const UnrolledIterator & o)	const	{ return block == o.block && index == o.index; }
+	private:
+		UnrolledBlock<T, B> *block;
+		int index;
+};
+
+// ============================== UNROLLED LIST ===========================================
+// B is the block capacity, Nodes selects how blocks are allocated, see NodePool.h
+template <class T, int B = 32, class Nodes = NodePool< UnrolledBlock<T, B> > >
+class UnrolledList {
+	static_assert(B >= 4, "UnrolledList: block capacity must be at least 4");
+public:
+	typedef UnrolledBlock<T, B> Block;
+
+	UnrolledList();
+	virtual ~UnrolledList();
+	UnrolledList(const UnrolledList & other);
+	void operator=(const UnrolledList & other);
+	bool operator==(const UnrolledList & other) const;
+	bool operator!=(const UnrolledList & other) const;
+
+	void clear();
+	void add(const T & value);
+	void add(int pos, const T & value);
+	void remove(int pos);
+	void set(int pos, const T & value);
+	T    get(int pos) const;
+	int  size() const;
+	bool isEmpty() const;
+	int  blocks() const;
+
+	void print(std::ostream & os) const;
+	int  find(const T & value) const;
+
+	// Iterators
+	UnrolledIterator<T, B> begin()			{ return UnrolledIterator<T, B>(head); }
+	UnrolledIterator<T, B> end()			{ return UnrolledIterator<T, B>(nullptr); }
+	UnrolledIterator<T, B> begin() const	{ return UnrolledIterator<T, B>(head); }
+	UnrolledIterator<T, B> end()   const	{ return UnrolledIterator<T, B>(nullptr); }
+
+private:
+	Block* blockAt(int pos, int & index, Block** prev = nullptr) const;
+	void deepCopy(const UnrolledList & c);
+
+	Block *head, *tail;
+	int count;
+	int nblocks;
+	Nodes nodes;
+};
+
+// ============================== UnrolledList Implementation ======================
+
+// Default Constructor
+template <class T, int B, class Nodes>
+UnrolledList<T, B, Nodes>::UnrolledList() : head(nullptr), tail(nullptr), count(0), nblocks(0) {}
+
+// Destructor
+template <class T, int B, class Nodes>
+UnrolledList<T, B, Nodes>::~UnrolledList() {
+	clear();
+}
+
+// PostCondition: construct UnrolledList as a duplicate of other
+template <class T, int B, class Nodes>
+UnrolledList<T, B, Nodes>::UnrolledList(const UnrolledList<T, B, Nodes> & other) : head(nullptr), tail(nullptr), count(0), nblocks(0) {
+	deepCopy(other);
+}
+
+// PreCondition: list is empty
+// PostCondition: copy of the elements of c, in full blocks
+template <class T, int B, class Nodes>
+void UnrolledList<T, B, Nodes>::deepCopy(const UnrolledList<T, B, Nodes> & c) {
+	for (UnrolledIterator<T, B> itr = c.begin(); itr != c.end(); ++itr) {
+		add(*itr);
+	}
+}
+
+// PostCondition: assign other to UnrolledList
+template <class T, int B, class Nodes>
+void UnrolledList<T, B, Nodes>::operator=(const UnrolledList<T, B, Nodes> & other) {
+	if (this != &other) {
+		clear();
+		deepCopy(other);
+	}
+}
+
+// PostCondition: test UnrolledLists for equality
+template <class T, int B, class Nodes>
+bool UnrolledList<T, B, Nodes>::operator==(const UnrolledList<T, B, Nodes> & other) const {
+	bool same = size() == other.size();
+	for (UnrolledIterator<T, B> itr = begin(), oitr = other.begin(); itr != end() && same; itr++, oitr++) {
+		if ((*itr) != (*oitr)) {
+			same = false;
+		}
+	}
+	return same;
+}
+
+template <class T, int B, class Nodes>
+bool UnrolledList<T, B, Nodes>::operator!=(const UnrolledList<T, B, Nodes> & other) const {
+	return !operator==(other);
+}
+
+// PostCondition: return number of elements in UnrolledList
+template <class T, int B, class Nodes>
+int UnrolledList<T, B, Nodes>::size() const {
+	return count;
+}
+
+// PostCondition: return number of blocks in use
+template <class T, int B, class Nodes>
+int UnrolledList<T, B, Nodes>::blocks() const {
+	return nblocks;
+}
+
+// PreCondition: pos is a valid insertion UnrolledList position
+// PostCondition: inserts element value at specified position, splitting a full block in two
+template <class T, int B, class Nodes>
+void UnrolledList<T, B, Nodes>::add(int pos, const T & value) {
+	if (pos < 0 || pos > size()) {
+		throw std::out_of_range("UnrolledList invalid position: " + std::to_string(pos));
+	}
+	Block* b;
+	int i;
+	if (pos == count) {
+		// append - start a new block when the last is full, leaving it full
+		if (tail == nullptr || tail->count == B) {
+			Block* n = nodes.create();
+			if (tail == nullptr) { head = n; } else { tail->next = n; }
+			tail = n;
+			nblocks++;
+		}
+		b = tail;
+		i = b->count;
+	} else {
+		b = blockAt(pos, i);
+		if (b->count == B) {
+			// split - move upper half to a new block following b
+			Block* n = nodes.create(b->next);
+			int half = B / 2;
+			std::move(b->items + half, b->items + B, n->items);
+			n->count = B - half;
+			b->count = half;
+			b->next = n;
+			if (tail == b) { tail = n; }
+			nblocks++;
+			if (i > half) {
+				b = n;
+				i -= half;
+			}
+		}
+		std::move_backward(b->items + i, b->items + b->count, b->items + b->count + 1);
+	}
+	b->items[i] = value;
+	b->count++;
+	count++;
+}
+
+// PostCondition: inserts element value at end of UnrolledList
+template <class T, int B, class Nodes>
+void UnrolledList<T, B, Nodes>::add(const T & value) {
+	add(size(), value);
+}
+
+// PreCondition: pos is a valid UnrolledList position
+// PostCondition: removes element at specified position. An empty block is released
+//                and a block less than half full absorbs its successor when they fit
+template <class T, int B, class Nodes>
+void UnrolledList<T, B, Nodes>::remove(int pos) {
+	if (pos < 0 || pos >= size()) {
+		throw std::out_of_range("UnrolledList invalid position: " + std::to_string(pos));
+	}
+	Block* prev;
+	int i;
+	Block* b = blockAt(pos, i, &prev);
+	std::move(b->items + i + 1, b->items + b->count, b->items + i);
+	b->count--;
+	count--;
+
+	if (b->count == 0) {
+		if (prev == nullptr) { head = b->next; } else { prev->next = b->next; }
+		if (tail == b) { tail = prev; }
+		nodes.destroy(b);
+		nblocks--;
+	} else if (b->count < B / 2 && b->next != nullptr && b->count + b->next->count <= B) {
+		Block* n = b->next;
+		std::move(n->items, n->items + n->count, b->items + b->count);
+		b->count += n->count;
+		b->next = n->next;
+		if (tail == n) { tail = b; }
+		nodes.destroy(n);
+		nblocks--;
+	}
+}
+
+// PreCondition: pos is a valid UnrolledList position
+// PostCondition: returns element at specified position
+template <class T, int B, class Nodes>
+T UnrolledList<T, B, Nodes>::get(int pos) const {
+	if (pos < 0 || pos >= size()) {
+		throw std::out_of_range("UnrolledList invalid position: " + std::to_string(pos));
+	}
+	int i;
+	return blockAt(pos, i)->items[i];
+}
+
+// PreCondition: pos is a valid UnrolledList position
+// PostCondition: updates element at specified position
+template <class T, int B, class Nodes>
+void UnrolledList<T, B, Nodes>::set(int pos, const T & value) {
+	if (pos < 0 || pos >= size()) {
+		throw std::out_of_range("UnrolledList invalid position: " + std::to_string(pos));
+	}
+	int i;
+	blockAt(pos, i)->items[i] = value;
+}
+
+// PostCondition: returns index of UnrolledList item if found or -1 if not found
+template <class T, int B, class Nodes>
+int UnrolledList<T, B, Nodes>::find(const T & value) const {
+	int first = 0;
+	for (Block* b = head; b != nullptr; b = b->next) {
+		for (int i = 0; i < b->count; i++) {
+			if (b->items[i] == value) {
+				return first + i;
+			}
+		}
+		first += b->count;
+	}
+	return -1;
+}
+
+// PostCondition: prints contents of UnrolledList to output stream
+template <class T, int B, class Nodes>
+void UnrolledList<T, B, Nodes>::print(std::ostream & os) const {
+	os << "[ ";
+	for (UnrolledIterator<T, B> itr = begin(); itr != end(); ++itr) {
+		os << (*itr) << " ";
+	}
+	os << "]";
+}
+
+// PreCondition:  pos is valid
+// PostCondition: returns block holding element pos, with index set to its position
+//                in the block and prev (when requested) to the preceding block
+template <class T, int B, class Nodes>
+UnrolledBlock<T, B>* UnrolledList<T, B, Nodes>::blockAt(int pos, int & index, Block** prev) const {
+	Block* p = nullptr;
+	Block* b = head;
+	if (prev == nullptr && pos >= count - tail->count) {	// IN LAST BLOCK
+		index = pos - (count - tail->count);
+		return tail;
+	}
+	while (pos >= b->count) {
+		pos -= b->count;
+		p = b;
+		b = b->next;
+	}
+	if (prev != nullptr) {
+		*prev = p;
+	}
+	index = pos;
+	return b;
+}
+
+// PostCondition: UnrolledList is emptied, all blocks are released together
+template <class T, int B, class Nodes>
+void UnrolledList<T, B, Nodes>::clear() {
+	if (!nodes.discardIsTrivial()) {
+		Block* b = head;
+		while (b != nullptr) {
+			Block* d = b;
+			b = b->next;
+			nodes.discard(d);
+		}
+	}
+	nodes.reset();
+	head = tail = nullptr;
+	count = 0;
+	nblocks = 0;
+}
+
+template <class T, int B, class Nodes>
+bool UnrolledList<T, B, Nodes>::isEmpty() const {
+	return (count == 0);
+}
+
+// PreCondition: None
+// PostCondition: overload << operator to output UnrolledList on ostream
+template <class T, int B, class Nodes>
+std::ostream& operator <<(std::ostream& output, const UnrolledList<T, B, Nodes>& l) {
+	l.print(output);
+	return output;
+}
+
+#endif /*UNROLLEDLIST_H*/